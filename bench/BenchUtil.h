@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace bench
+{
+    // Shape of a synthetic store. The defaults are the store every bench
+    // uses: 3-10 words per description and an even status mix.
+    struct StoreSpec
+    {
+        size_t count = 0;
+        // Words per description, uniform in [minWords, maxWords]
+        size_t minWords = 3;
+        size_t maxWords = 10;
+        // Long tail: this percentage of tasks gets longWords words instead
+        unsigned longPercent = 0;
+        size_t longWords = 200;
+        // Relative weights of TODO, IN_PROGRESS and DONE
+        std::array<unsigned, 3> statusWeights{1, 1, 1};
+
+        bool IsDefault() const noexcept
+        {
+            return minWords == 3 && maxWords == 10 && longPercent == 0
+                && statusWeights == std::array<unsigned, 3>{1, 1, 1};
+        }
+    };
+
+    // Writes a synthetic store in the task-tracker.json layout. Files are
+    // cached in the temp directory, named after the spec, and reused
+    // across runs; a given spec always yields the same bytes.
+    inline std::filesystem::path SyntheticStore(const StoreSpec& spec)
+    {
+        namespace fs = std::filesystem;
+        std::string name = "bench-task-tracker-" + std::to_string(spec.count);
+        if (!spec.IsDefault())
+        {
+            name += "-w" + std::to_string(spec.minWords) + "-" + std::to_string(spec.maxWords)
+                + "-l" + std::to_string(spec.longPercent) + "x" + std::to_string(spec.longWords)
+                + "-s" + std::to_string(spec.statusWeights[0]) + "." + std::to_string(spec.statusWeights[1])
+                + "." + std::to_string(spec.statusWeights[2]);
+        }
+        fs::path path = fs::temp_directory_path() / (name + ".json");
+        if (fs::exists(path))
+            return path;
+
+        static constexpr const char* statuses[] = {"TODO", "IN_PROGRESS", "DONE"};
+        static constexpr const char* words[] = {
+            "review", "deploy", "fix", "write", "update", "cleanup", "release",
+            "parser", "docs", "tests", "build", "service", "client", "store"
+        };
+        const unsigned weightSum = spec.statusWeights[0] + spec.statusWeights[1] + spec.statusWeights[2];
+
+        // Write to a temp name first, an interrupted run must not leave a
+        // truncated store in the cache
+        fs::path tmp = path;
+        tmp += ".tmp";
+        std::mt19937 rng{42};
+        std::ofstream out{tmp, std::ios::trunc};
+        out << "[\n";
+        for (size_t i = 0; i < spec.count; ++i)
+        {
+            std::ostringstream desc;
+            size_t nwords = spec.minWords + rng() % (spec.maxWords - spec.minWords + 1);
+            if (spec.longPercent && rng() % 100 < spec.longPercent)
+                nwords = spec.longWords;
+            for (size_t w = 0; w < nwords; ++w)
+                desc << (w ? " " : "") << words[rng() % std::size(words)];
+            desc << " #" << i;
+
+            unsigned pick = rng() % weightSum;
+            size_t status = 0;
+            while (pick >= spec.statusWeights[status])
+                pick -= spec.statusWeights[status++];
+
+            out << "    {\n"
+                << "        \"id\": " << i + 1 << ",\n"
+                << "        \"description\": \"" << desc.str() << "\",\n"
+                << "        \"status\": \"" << statuses[status] << "\",\n"
+                << "        \"createdAt\": \"2025-08-02 23:08:45\",\n"
+                << "        \"updatedAt\": \"" << (i % 2 ? "2025-08-03 09:48:07" : "null") << "\"\n"
+                << "    }" << (i + 1 < spec.count ? "," : "") << "\n";
+        }
+        out << "]\n";
+        out.close();
+        fs::rename(tmp, path);
+        return path;
+    }
+
+    inline std::filesystem::path SyntheticStore(size_t count)
+    {
+        return SyntheticStore(StoreSpec{count});
+    }
+
+    inline std::string ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream in{path, std::ios::binary};
+        std::ostringstream oss;
+        oss << in.rdbuf();
+        return oss.str();
+    }
+}
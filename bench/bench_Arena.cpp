@@ -0,0 +1,131 @@
+#include "BenchUtil.h"
+#include "../src/FileIO.h"
+#include "../src/StringArena.h"
+#include "../src/TaskList.h"
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <memory>
+
+#ifdef __GLIBC__
+    #include <malloc.h>
+#endif
+
+namespace
+{
+    // The synthetic store with quoted descriptions, so none of them can be
+    // borrowed from the mapping
+    std::filesystem::path EscapedStore(size_t count)
+    {
+        auto path = std::filesystem::temp_directory_path()
+            / ("bench-task-tracker-escaped-" + std::to_string(count) + ".json");
+        if (!std::filesystem::exists(path))
+        {
+            std::vector<Task> tasks;
+            TaskList::ParseTasks(bench::ReadFile(bench::SyntheticStore(count)), tasks);
+            for (auto& task : tasks)
+                task.UpdateTask("\"" + std::string(task.GetDescription()) + "\"");
+            TaskList::WriteTasks(tasks, path);
+        }
+        return path;
+    }
+
+    // Resident memory that is not backed by a file, i.e. not the mapped store
+    double AnonymousMb()
+    {
+        long size = 0, resident = 0, shared = 0;
+        std::ifstream statm{"/proc/self/statm"};
+        statm >> size >> resident >> shared;
+        return static_cast<double>(resident - shared) * 4096 / (1 << 20);
+    }
+
+    // Heap the allocator holds on to without handing it out
+    double HeapFreeMb()
+    {
+#ifdef __GLIBC__
+        return static_cast<double>(mallinfo2().fordblks) / (1 << 20);
+#else
+        return 0;
+#endif
+    }
+
+    // Loads with an arena if one is given, heap-allocated descriptions otherwise
+    void Load(const MappedFile& file, std::vector<Task>& tasks, StringArena* arena)
+    {
+        tasks.reserve(1'000'000);
+        TaskList::ParseTasks(file.View(), tasks, true, arena);
+    }
+}
+
+// Arg: tasks; the second argument selects heap (0) or arena (1)
+static void BM_LoadEscaped(benchmark::State& state)
+{
+    MappedFile file;
+    file.Open(EscapedStore(state.range(0)));
+    auto arena = state.range(1) ? std::make_unique<StringArena>() : nullptr;
+    for (auto _ : state)
+    {
+        std::vector<Task> tasks;
+        Load(file, tasks, arena.get());
+        benchmark::DoNotOptimize(tasks.data());
+
+        state.PauseTiming();
+        tasks = {};
+        if (arena)
+            arena->Release();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadEscaped)->ArgsProduct({{100'000, 1'000'000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_TeardownEscaped(benchmark::State& state)
+{
+    MappedFile file;
+    file.Open(EscapedStore(state.range(0)));
+    auto arena = state.range(1) ? std::make_unique<StringArena>() : nullptr;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<Task> tasks;
+        Load(file, tasks, arena.get());
+        state.ResumeTiming();
+
+        tasks = {};
+        if (arena)
+            arena->Release();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TeardownEscaped)->ArgsProduct({{100'000, 1'000'000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// A long-running process reloading its store: every reload keeps a few
+// tasks alive (the way a cache or a view would), which pins the heap pages
+// around them. Reports anonymous resident memory and free-but-retained heap afterwards.
+static void BM_ReloadFragmentation(benchmark::State& state)
+{
+    MappedFile file;
+    file.Open(EscapedStore(1'000'000));
+    auto arena = state.range(0) ? std::make_unique<StringArena>() : nullptr;
+    std::vector<Task> survivors;
+    for (auto _ : state)
+    {
+        for (int reload = 0; reload < 4; ++reload)
+        {
+            std::vector<Task> tasks;
+            Load(file, tasks, arena.get());
+            for (size_t i = 0; i < tasks.size(); i += 997)
+                survivors.push_back(tasks[i]);
+            tasks = {};
+            if (arena)
+                arena->Release();
+        }
+    }
+    state.counters["anon_mb"] = AnonymousMb();
+    state.counters["heap_free_mb"] = HeapFreeMb();
+    benchmark::DoNotOptimize(survivors.data());
+}
+BENCHMARK(BM_ReloadFragmentation)->Arg(0)->Arg(1)->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
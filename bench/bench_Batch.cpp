@@ -0,0 +1,103 @@
+#include "BenchUtil.h"
+#include "../src/Command.h"
+#include <benchmark/benchmark.h>
+#include <sstream>
+
+namespace
+{
+    constexpr size_t STORE_SIZE = 10'000;
+
+    // Fresh copy of the synthetic store, so every run starts from the same state
+    std::filesystem::path ScratchStore()
+    {
+        auto path = std::filesystem::temp_directory_path() / "bench-task-tracker-batch.json";
+        auto journal = path;
+        journal += ".journal";
+        std::filesystem::remove(journal);
+        std::filesystem::copy_file(bench::SyntheticStore(STORE_SIZE), path,
+            std::filesystem::copy_options::overwrite_existing);
+        return path;
+    }
+
+    TaskListOptions JournalOptions()
+    {
+        TaskListOptions options;
+        options.persistence = TaskListOptions::Persistence::JOURNAL;
+        return options;
+    }
+
+    // Alternating adds and marks, as the automation sends them
+    std::string Commands(size_t count)
+    {
+        std::string out;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i % 2 == 0)
+                out += "add \"Automated task " + std::to_string(i) + "\"\n";
+            else
+                out += "mark-done " + std::to_string(i % STORE_SIZE + 1) + "\n";
+        }
+        return out;
+    }
+}
+
+// What one task-cli process per command pays, minus the process start:
+// load, execute, persist
+static void BM_CommandPerLoad(benchmark::State& state)
+{
+    auto path = ScratchStore();
+    char program[] = "task-cli";
+    char verb[] = "mark-done";
+    char id[] = "42";
+    char* argv[] = {program, verb, id, nullptr};
+    auto command = *ParseArguments(3, argv);
+    for (auto _ : state)
+    {
+        TaskList tasks(path, JournalOptions());
+        benchmark::DoNotOptimize(ExecuteCommand(command, tasks));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CommandPerLoad)->Unit(benchmark::kMillisecond);
+
+// The same commands through one batch: one load, one persist
+static void BM_Batch(benchmark::State& state)
+{
+    const std::string commands = Commands(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto path = ScratchStore();
+        std::istringstream in(commands);
+        std::ostringstream report;
+        state.ResumeTiming();
+
+        // Synced in groups like task-cli batch
+        TaskListOptions options = JournalOptions();
+        options.groupCommit = 256;
+        TaskList tasks(path, options);
+        auto result = RunBatch(in, tasks, report);
+        benchmark::DoNotOptimize(result.failed);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Batch)->Arg(100)->Arg(10'000)->Unit(benchmark::kMillisecond);
+
+// Cost of durability: 1024 marks on one list, fsynced in groups of
+// state.range(0) records; 0 leaves flushing to the OS
+static void BM_GroupCommit(benchmark::State& state)
+{
+    auto path = ScratchStore();
+    TaskListOptions options = JournalOptions();
+    options.durable = state.range(0) > 0;
+    options.groupCommit = static_cast<size_t>(state.range(0));
+    TaskList tasks(path, options);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        for (int n = 0; n < 1024; ++n, ++i)
+            tasks.MarkTask(static_cast<int>(i % STORE_SIZE) + 1, i % 2 ? Task::Status::DONE : Task::Status::TODO);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_GroupCommit)->Arg(0)->Arg(1)->Arg(8)->Arg(64)->Arg(512)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,241 @@
+#include "BenchUtil.h"
+#include "../src/TaskColumns.h"
+#include "../src/TaskList.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    constexpr size_t COUNT = 1'000'000;
+    const auto BASE = std::chrono::system_clock::time_point{std::chrono::seconds{1'700'000'000}};
+
+    // 1M tasks created a minute apart, every third one updated an hour later
+    const std::vector<Task>& Tasks()
+    {
+        static const std::vector<Task> tasks = [] {
+            std::vector<Task> parsed;
+            TaskList::ParseTasks(bench::ReadFile(bench::SyntheticStore(COUNT)), parsed);
+            std::vector<Task> out;
+            out.reserve(parsed.size());
+            for (size_t i = 0; i < parsed.size(); ++i)
+            {
+                auto created = BASE + std::chrono::minutes(i);
+                std::optional<std::chrono::system_clock::time_point> updated;
+                if (i % 3 == 0)
+                    updated = created + std::chrono::hours(1);
+                out.emplace_back(parsed[i].GetId(), parsed[i].GetDescription(), parsed[i].GetStatus(), 
+                    created, updated);
+            }
+            return out;
+        }();
+        return tasks;
+    }
+
+    const TaskColumns& Columns()
+    {
+        static const TaskColumns columns = [] {
+            TaskColumns out;
+            out.Assign(Tasks());
+            return out;
+        }();
+        return columns;
+    }
+
+    // The middle tenth of the creation times
+    auto From() { return BASE + std::chrono::minutes(COUNT * 45 / 100); }
+    auto To() { return BASE + std::chrono::minutes(COUNT * 55 / 100); }
+}
+
+// One field over all tasks, array of Tasks versus one column
+
+static void BM_ScanIdsAoS(benchmark::State& state)
+{
+    const auto& tasks = Tasks();
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (const Task& task : tasks)
+            sum += task.GetId();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_ScanIdsAoS)->Unit(benchmark::kMicrosecond);
+
+static void BM_ScanIdsColumn(benchmark::State& state)
+{
+    const auto ids = Columns().Ids();
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (int id : ids)
+            sum += id;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_ScanIdsColumn)->Unit(benchmark::kMicrosecond);
+
+static void BM_ScanCreatedAoS(benchmark::State& state)
+{
+    const auto& tasks = Tasks();
+    const auto from = From();
+    const auto to = To();
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        for (const Task& task : tasks)
+            hits += task.GetCreatedAt() >= from && task.GetCreatedAt() <= to;
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_ScanCreatedAoS)->Unit(benchmark::kMicrosecond);
+
+static void BM_ScanCreatedColumn(benchmark::State& state)
+{
+    const auto created = Columns().CreatedAt();
+    const auto from = TaskColumns::ToRep(From());
+    const auto to = TaskColumns::ToRep(To());
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        for (auto value : created)
+            hits += value >= from && value <= to;
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_ScanCreatedColumn)->Unit(benchmark::kMicrosecond);
+
+static void BM_ScanUpdatedAoS(benchmark::State& state)
+{
+    const auto& tasks = Tasks();
+    const auto from = From();
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        for (const Task& task : tasks)
+        {
+            auto updated = task.GetUpdatedAt();
+            hits += updated && *updated >= from;
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_ScanUpdatedAoS)->Unit(benchmark::kMicrosecond);
+
+static void BM_ScanUpdatedColumn(benchmark::State& state)
+{
+    const auto updated = Columns().UpdatedAt();
+    const auto from = TaskColumns::ToRep(From());
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        for (auto value : updated)
+            hits += value != TaskColumns::NEVER && value >= from;
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_ScanUpdatedColumn)->Unit(benchmark::kMicrosecond);
+
+static void BM_ScanStatusAoS(benchmark::State& state)
+{
+    const auto& tasks = Tasks();
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        for (const Task& task : tasks)
+            hits += task.GetStatus() == Task::Status::DONE;
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_ScanStatusAoS)->Unit(benchmark::kMicrosecond);
+
+static void BM_ScanStatusBits(benchmark::State& state)
+{
+    static const StatusIndex index = [] {
+        StatusIndex out;
+        out.Assign(Tasks());
+        return out;
+    }();
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        index.ForEach(Task::Status::DONE, 0, COUNT, [&](size_t) { ++hits; });
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_ScanStatusBits)->Unit(benchmark::kMicrosecond);
+
+// TaskList over the same tasks, saved once to a temp store
+static const TaskList& List()
+{
+    static const TaskList& list = *[] {
+        auto path = std::filesystem::temp_directory_path() / "bench-task-tracker-columns.json";
+        if (!std::filesystem::exists(path))
+            TaskList::WriteTasks(Tasks(), path);
+        // Journal mode without mutations never writes the store back
+        TaskListOptions options;
+        options.persistence = TaskListOptions::Persistence::JOURNAL;
+        return new TaskList(path, options);
+    }();
+    return list;
+}
+
+// End to end: TaskList::Select with a creation range and a status
+static void BM_SelectCreatedRange(benchmark::State& state)
+{
+    const TaskList& list = List();
+    TaskFilter filter;
+    filter.status = Task::Status::DONE;
+    filter.createdFrom = From();
+    filter.createdTo = To();
+    for (auto _ : state)
+    {
+        auto view = list.Select(filter);
+        benchmark::DoNotOptimize(view.size());
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_SelectCreatedRange)->Unit(benchmark::kMicrosecond);
+
+// The Arg most recently updated tasks: sorting every match, then cutting
+static void BM_RecentFullSort(benchmark::State& state)
+{
+    const TaskList& list = List();
+    for (auto _ : state)
+    {
+        std::vector<const Task*> all;
+        for (const Task& task : list.Select({}))
+            all.push_back(&task);
+        std::sort(all.begin(), all.end(), [](const Task* a, const Task* b) {
+            return a->GetUpdatedAt() > b->GetUpdatedAt();
+        });
+        all.resize(std::min<size_t>(all.size(), state.range(0)));
+        benchmark::DoNotOptimize(all.data());
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_RecentFullSort)->Arg(20)->Unit(benchmark::kMillisecond);
+
+// ... and the partial sort over the updatedAt column
+static void BM_RecentTopK(benchmark::State& state)
+{
+    const TaskList& list = List();
+    TaskOrder order;
+    order.key = TaskOrder::Key::UPDATED;
+    order.descending = true;
+    order.limit = state.range(0);
+    for (auto _ : state)
+    {
+        auto view = list.Select({}, order);
+        benchmark::DoNotOptimize(view.size());
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+}
+BENCHMARK(BM_RecentTopK)->Arg(20)->Arg(1000)->Unit(benchmark::kMillisecond);
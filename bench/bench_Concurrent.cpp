@@ -0,0 +1,126 @@
+#include "BenchUtil.h"
+#include "../src/ConcurrentTaskList.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+
+namespace
+{
+    constexpr size_t STORE_SIZE = 100'000;
+
+    std::filesystem::path ScratchStore(const char* name)
+    {
+        auto path = std::filesystem::temp_directory_path() / name;
+        std::filesystem::copy_file(bench::SyntheticStore(STORE_SIZE), path,
+            std::filesystem::copy_options::overwrite_existing);
+        return path;
+    }
+
+    ConcurrentTaskList& Concurrent()
+    {
+        static ConcurrentTaskList tasks(ScratchStore("bench-task-tracker-concurrent.json"));
+        return tasks;
+    }
+
+    // Baseline: the plain list behind a reader/writer lock, as in TaskServer
+    struct Locked
+    {
+        TaskList tasks{ScratchStore("bench-task-tracker-locked.json")};
+        std::shared_mutex mutex;
+    };
+
+    Locked& Baseline()
+    {
+        static Locked locked;
+        return locked;
+    }
+
+    // One writer marking tasks round robin while a benchmark runs
+    std::atomic<bool> g_writing{false};
+    std::thread g_writer;
+
+    template <typename Mark>
+    void StartWriter(Mark mark)
+    {
+        g_writing = true;
+        g_writer = std::thread([mark] {
+            for (size_t i = 0; g_writing; ++i)
+                mark(static_cast<int>(i % STORE_SIZE) + 1, i % 2 ? Task::Status::DONE : Task::Status::IN_PROGRESS);
+        });
+    }
+
+    void StopWriter(const benchmark::State&)
+    {
+        g_writing = false;
+        g_writer.join();
+    }
+
+    // Small status query over an id window, the typical read
+    TaskFilter Window(size_t i)
+    {
+        int first = static_cast<int>(i * 7919 % STORE_SIZE) + 1;
+        return {.status = Task::Status::IN_PROGRESS, .minId = first, .maxId = first + 63};
+    }
+}
+
+static void BM_SnapshotRead(benchmark::State& state)
+{
+    auto& tasks = Concurrent();
+    size_t i = static_cast<size_t>(state.thread_index()) * 1000;
+    for (auto _ : state)
+    {
+        auto snapshot = tasks.Snapshot();
+        benchmark::DoNotOptimize(snapshot->Select(Window(i++)).size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SnapshotRead)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_LockedRead(benchmark::State& state)
+{
+    auto& locked = Baseline();
+    size_t i = static_cast<size_t>(state.thread_index()) * 1000;
+    for (auto _ : state)
+    {
+        std::shared_lock lock(locked.mutex);
+        benchmark::DoNotOptimize(locked.tasks.Select(Window(i++)).size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LockedRead)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_SnapshotReadWhileWriting(benchmark::State& state)
+{
+    BM_SnapshotRead(state);
+}
+BENCHMARK(BM_SnapshotReadWhileWriting)->ThreadRange(1, 32)->UseRealTime()
+    ->Setup([](const benchmark::State&) {
+        StartWriter([](int id, Task::Status status) { Concurrent().MarkTask(id, status); });
+    })
+    ->Teardown(StopWriter);
+
+static void BM_LockedReadWhileWriting(benchmark::State& state)
+{
+    BM_LockedRead(state);
+}
+BENCHMARK(BM_LockedReadWhileWriting)->ThreadRange(1, 32)->UseRealTime()
+    ->Setup([](const benchmark::State&) {
+        StartWriter([](int id, Task::Status status) {
+            std::unique_lock lock(Baseline().mutex);
+            Baseline().tasks.MarkTask(id, status);
+        });
+    })
+    ->Teardown(StopWriter);
+
+static void BM_ConcurrentMark(benchmark::State& state)
+{
+    auto& tasks = Concurrent();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        tasks.MarkTask(static_cast<int>(i % STORE_SIZE) + 1, i % 2 ? Task::Status::DONE : Task::Status::TODO);
+        ++i;
+    }
+}
+BENCHMARK(BM_ConcurrentMark)->Unit(benchmark::kMicrosecond);
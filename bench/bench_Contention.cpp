@@ -0,0 +1,119 @@
+#include "BenchUtil.h"
+#include "../src/TaskList.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr size_t STORE_SIZE = 1'000;
+    constexpr int ADDS_PER_PROCESS = 200;
+
+    std::filesystem::path FreshStore()
+    {
+        auto path = std::filesystem::temp_directory_path() / "bench-task-tracker-contention.json";
+        auto journal = path;
+        journal += ".journal";
+        std::filesystem::remove(journal);
+        std::filesystem::copy_file(bench::SyntheticStore(STORE_SIZE), path,
+            std::filesystem::copy_options::overwrite_existing);
+        return path;
+    }
+
+    TaskListOptions Options(TaskListOptions::Persistence persistence)
+    {
+        TaskListOptions options;
+        options.persistence = persistence;
+        options.journalCompactBytes = 16 * 1024;
+        return options;
+    }
+
+    // Runs work in state.range(0) processes at once, work returns the
+    // number of failed adds
+    template <typename Work>
+    void InProcesses(benchmark::State& state, Work work)
+    {
+#ifdef _WIN32
+        state.SkipWithError("fork only");
+        return;
+#else
+        const int processes = static_cast<int>(state.range(0));
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            auto path = FreshStore();
+            state.ResumeTiming();
+
+            std::vector<pid_t> children;
+            for (int p = 0; p < processes; ++p)
+            {
+                pid_t pid = fork();
+                if (pid == 0)
+                    _exit(work(path) == 0 ? 0 : 1);
+                children.push_back(pid);
+            }
+            for (pid_t pid : children)
+            {
+                int status = 0;
+                waitpid(pid, &status, 0);
+                if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                    state.SkipWithError("lost updates");
+            }
+
+            state.PauseTiming();
+            TaskList tasks(path, Options(TaskListOptions::Persistence::JOURNAL));
+            if (tasks.Size() != STORE_SIZE + static_cast<size_t>(processes) * ADDS_PER_PROCESS)
+                state.SkipWithError("lost updates");
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations() * processes * ADDS_PER_PROCESS);
+#endif
+    }
+}
+
+// One short task-cli run per add: load, add, save
+static void BM_SessionsJournal(benchmark::State& state)
+{
+    InProcesses(state, [](const std::filesystem::path& path) {
+        int failed = 0;
+        for (int i = 0; i < ADDS_PER_PROCESS; ++i)
+        {
+            TaskList tasks(path, Options(TaskListOptions::Persistence::JOURNAL));
+            failed += !tasks.AddTask("added by a session");
+        }
+        return failed;
+    });
+}
+BENCHMARK(BM_SessionsJournal)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_SessionsRewrite(benchmark::State& state)
+{
+    InProcesses(state, [](const std::filesystem::path& path) {
+        int failed = 0;
+        for (int i = 0; i < ADDS_PER_PROCESS; ++i)
+        {
+            TaskList tasks(path, Options(TaskListOptions::Persistence::REWRITE));
+            failed += !tasks.AddTask("added by a session");
+        }
+        return failed;
+    });
+}
+BENCHMARK(BM_SessionsRewrite)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Long-lived lists, every add takes the lock and catches up with the others
+static void BM_ResidentJournal(benchmark::State& state)
+{
+    InProcesses(state, [](const std::filesystem::path& path) {
+        int failed = 0;
+        TaskList tasks(path, Options(TaskListOptions::Persistence::JOURNAL));
+        for (int i = 0; i < ADDS_PER_PROCESS; ++i)
+            failed += !tasks.AddTask("added by a resident list");
+        return failed;
+    });
+}
+BENCHMARK(BM_ResidentJournal)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,136 @@
+#include "BenchUtil.h"
+#include "../src/BinarySnapshot.h"
+#include "../src/FileIO.h"
+#include "../src/TaskList.h"
+#include <benchmark/benchmark.h>
+
+// Parse an in-memory store into Tasks
+static void BM_ParseTasks(benchmark::State& state)
+{
+    const std::string json = bench::ReadFile(bench::SyntheticStore(state.range(0)));
+    for (auto _ : state)
+    {
+        std::vector<Task> tasks;
+        tasks.reserve(state.range(0));
+        bool ok = TaskList::ParseTasks(json, tasks);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(tasks.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_ParseTasks)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// Parse a mapped store on several threads. Args: store size, chunks
+static void BM_ParseParallel(benchmark::State& state)
+{
+    MappedFile file;
+    file.Open(bench::SyntheticStore(state.range(0)));
+    for (auto _ : state)
+    {
+        std::vector<Task> tasks;
+        bool ok = TaskList::ParseTasksParallel(file.View(), tasks, state.range(1), true);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(tasks.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(file.View().size()));
+}
+BENCHMARK(BM_ParseParallel)->ArgsProduct({{1'000'000}, {1, 2, 4, 8, 16}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Read the file and parse it, the full load path of the TaskList constructor
+static void BM_LoadFile(benchmark::State& state)
+{
+    const auto path = bench::SyntheticStore(state.range(0));
+    int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        std::string json = bench::ReadFile(path);
+        std::vector<Task> tasks;
+        bool ok = TaskList::ParseTasks(json, tasks);
+        benchmark::DoNotOptimize(ok);
+        bytes += static_cast<int64_t>(json.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_LoadFile)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// Map the file and parse it with borrowed descriptions
+static void BM_LoadMapped(benchmark::State& state)
+{
+    const auto path = bench::SyntheticStore(state.range(0));
+    int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        MappedFile file;
+        file.Open(path);
+        std::vector<Task> tasks;
+        bool ok = TaskList::ParseTasks(file.View(), tasks, true);
+        benchmark::DoNotOptimize(ok);
+        bytes += static_cast<int64_t>(file.View().size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_LoadMapped)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// Binary snapshot of the same synthetic store
+static std::filesystem::path SyntheticBinaryStore(size_t count)
+{
+    auto path = std::filesystem::temp_directory_path()
+        / ("bench-task-tracker-" + std::to_string(count) + ".bin");
+    if (!std::filesystem::exists(path))
+    {
+        std::vector<Task> tasks;
+        TaskList::ParseTasks(bench::ReadFile(bench::SyntheticStore(count)), tasks);
+        BinarySnapshot::Write(tasks, path);
+    }
+    return path;
+}
+
+// Map a binary snapshot and decode it, the JSON counterpart is BM_LoadMapped
+static void BM_LoadBinary(benchmark::State& state)
+{
+    const auto path = SyntheticBinaryStore(state.range(0));
+    int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        MappedFile file;
+        file.Open(path);
+        std::vector<Task> tasks;
+        bool ok = BinarySnapshot::Read(file.View(), tasks);
+        benchmark::DoNotOptimize(ok);
+        bytes += static_cast<int64_t>(file.View().size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_LoadBinary)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// task-cli mark-done 42 on a journaled store: load, one mutation, destroy.
+// Arg: store size; the second argument turns lazy loading on.
+static void BM_MarkOneTask(benchmark::State& state)
+{
+    const auto path = bench::SyntheticStore(state.range(0));
+    auto journal = path;
+    journal += ".journal";
+    TaskListOptions options;
+    options.persistence = TaskListOptions::Persistence::JOURNAL;
+    options.lazy = state.range(1) != 0;
+    for (auto _ : state)
+    {
+        TaskList tasks(path, options);
+        bool ok = tasks.MarkTask(42, Task::Status::DONE);
+        benchmark::DoNotOptimize(ok);
+    }
+    std::filesystem::remove(journal);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MarkOneTask)->ArgsProduct({{100'000, 1'000'000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,60 @@
+#include "BenchUtil.h"
+#include "../src/TaskList.h"
+#include "../src/TaskPrinter.h"
+#include <benchmark/benchmark.h>
+#include <fstream>
+
+namespace
+{
+    constexpr size_t COUNT = 1'000'000;
+
+    const std::vector<Task>& Tasks()
+    {
+        static const std::vector<Task> tasks = [] {
+            std::vector<Task> out;
+            TaskList::ParseTasks(bench::ReadFile(bench::SyntheticStore(COUNT)), out);
+            return out;
+        }();
+        return tasks;
+    }
+
+    // Lines one task takes in each format
+    constexpr int LINES[] = {5, 1, 1, 1};
+}
+
+// Every task through Task::PrintTask, one operator<< per piece
+static void BM_PrintTaskStream(benchmark::State& state)
+{
+    const auto& tasks = Tasks();
+    std::ofstream out{"/dev/null"};
+    for (auto _ : state)
+    {
+        for (const Task& task : tasks)
+            task.PrintTask(out);
+        out.flush();
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+    state.counters["lines"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * COUNT * LINES[0]), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_PrintTaskStream)->Unit(benchmark::kMillisecond);
+
+// Arg: TaskPrinter::Format (text, table, jsonl, tsv)
+static void BM_TaskPrinter(benchmark::State& state)
+{
+    const auto& tasks = Tasks();
+    const auto format = static_cast<TaskPrinter::Format>(state.range(0));
+    std::ofstream out{"/dev/null"};
+    for (auto _ : state)
+    {
+        TaskPrinter printer(out, format);
+        for (const Task& task : tasks)
+            printer.Print(task);
+        printer.Flush();
+        out.flush();
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+    state.counters["lines"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * COUNT * LINES[state.range(0)]), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_TaskPrinter)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
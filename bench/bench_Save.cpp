@@ -0,0 +1,163 @@
+#include "BenchUtil.h"
+#include "../src/BinarySnapshot.h"
+#include "../src/JsonWriter.h"
+#include "../src/TaskList.h"
+#include <benchmark/benchmark.h>
+#include <iomanip>
+
+namespace
+{
+    std::vector<Task> LoadTasks(size_t count)
+    {
+        std::vector<Task> tasks;
+        TaskList::ParseTasks(bench::ReadFile(bench::SyntheticStore(count)), tasks);
+        return tasks;
+    }
+
+    std::filesystem::path OutputPath()
+    {
+        return std::filesystem::temp_directory_path() / "bench-task-tracker-save.json";
+    }
+
+    // The previous save path: one ofstream, operator<< per field and
+    // put_time for every timestamp
+    void PutTime(std::ostream& os, std::chrono::system_clock::time_point tp)
+    {
+        std::time_t t = std::chrono::system_clock::to_time_t(tp);
+        std::tm tm{};
+        localtime_r(&t, &tm);
+        os << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+    }
+
+    void WriteOstream(const std::vector<Task>& tasks, const std::filesystem::path& path)
+    {
+        std::ofstream out{path, std::ios::trunc};
+        out << "[\n";
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            const Task& task = tasks[i];
+            out << "    {\n"
+                << "        \"id\": " << task.GetId() << ",\n"
+                << "        \"description\": \"" << task.GetDescription() << "\",\n"
+                << "        \"status\": \"" << Task::toString(task.GetStatus()) << "\",\n"
+                << "        \"createdAt\": \"";
+            PutTime(out, task.GetCreatedAt());
+            out << "\",\n        \"updatedAt\": \"";
+            if (task.GetUpdatedAt()) PutTime(out, *task.GetUpdatedAt());
+            else out << "null";
+            out << "\"\n    }" << (i + 1 < tasks.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+}
+
+// Serialize into memory only
+static void BM_SerializeJson(benchmark::State& state)
+{
+    const auto tasks = LoadTasks(state.range(0));
+    JsonWriter writer;
+    for (auto _ : state)
+    {
+        writer.Clear();
+        for (const auto& task : tasks)
+            writer.AppendTask(task, 4);
+        benchmark::DoNotOptimize(writer.View().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(writer.Size()));
+}
+BENCHMARK(BM_SerializeJson)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// Full save through std::ofstream, as before JsonWriter
+static void BM_SaveOstream(benchmark::State& state)
+{
+    const auto tasks = LoadTasks(state.range(0));
+    const auto path = OutputPath();
+    for (auto _ : state)
+        WriteOstream(tasks, path);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SaveOstream)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// Full save through JsonWriter and OutputFile
+static void BM_SaveJson(benchmark::State& state)
+{
+    const auto tasks = LoadTasks(state.range(0));
+    const auto path = OutputPath();
+    for (auto _ : state)
+    {
+        bool ok = TaskList::WriteTasks(tasks, path);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SaveJson)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// Save throughput by thread count. Args: store size, threads
+static void BM_SaveJsonParallel(benchmark::State& state)
+{
+    const auto tasks = LoadTasks(state.range(0));
+    const auto path = OutputPath();
+    for (auto _ : state)
+    {
+        bool ok = TaskList::WriteTasks(tasks, path, state.range(1));
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path)));
+}
+BENCHMARK(BM_SaveJsonParallel)->ArgsProduct({{1'000'000}, {1, 2, 4, 8, 16}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Binary snapshot for comparison
+static void BM_SaveBinary(benchmark::State& state)
+{
+    const auto tasks = LoadTasks(state.range(0));
+    const auto path = OutputPath().replace_extension(".snap");
+    for (auto _ : state)
+    {
+        bool ok = BinarySnapshot::Write(tasks, path);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SaveBinary)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// Whole save pipeline of a 10k store: temp file, rename, and with
+// state.range(0) the fsyncs of file and directory
+static void BM_ReplaceStore(benchmark::State& state)
+{
+    const auto path = OutputPath();
+    std::filesystem::copy_file(bench::SyntheticStore(10'000), path,
+        std::filesystem::copy_options::overwrite_existing);
+    TaskListOptions options;
+    options.durable = state.range(0) != 0;
+    TaskList tasks(path, options);
+    for (auto _ : state)
+    {
+        bool ok = tasks.SaveAs(path, TaskListOptions::Format::JSON);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_ReplaceStore)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// A read-only session in rewrite mode: load, list one status, destroy.
+// A clean list skips the save on destruction.
+static void BM_ReadOnlySession(benchmark::State& state)
+{
+    const auto path = OutputPath();
+    std::filesystem::copy_file(bench::SyntheticStore(state.range(0)), path,
+        std::filesystem::copy_options::overwrite_existing);
+    std::ofstream null{"/dev/null"};
+    for (auto _ : state)
+    {
+        TaskList tasks(path);
+        tasks.ListTasks("done", null);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadOnlySession)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
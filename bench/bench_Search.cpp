@@ -0,0 +1,152 @@
+#include "BenchUtil.h"
+#include "../src/KeywordIndex.h"
+#include "../src/SubstringScan.h"
+#include "../src/TaskList.h"
+#include <benchmark/benchmark.h>
+#include <map>
+
+namespace
+{
+    const std::vector<Task>& Tasks(size_t count)
+    {
+        static std::map<size_t, std::vector<Task>> cache;
+        auto& tasks = cache[count];
+        if (tasks.empty())
+            TaskList::ParseTasks(bench::ReadFile(bench::SyntheticStore(count)), tasks);
+        return tasks;
+    }
+
+    const KeywordIndex& Index(size_t count)
+    {
+        static std::map<size_t, KeywordIndex> cache;
+        auto [it, inserted] = cache.try_emplace(count);
+        if (inserted)
+        {
+            for (const auto& task : Tasks(count))
+                it->second.Add(task.GetId(), task.GetDescription());
+            // Sort the vocabulary for prefix queries outside the timing
+            it->second.Query("a*");
+        }
+        return it->second;
+    }
+
+    constexpr const char* QUERIES[] = {"parser", "parser deploy", "rel*", "docs OR client"};
+}
+
+// Building the index from scratch, the cost of the first search
+static void BM_IndexBuild(benchmark::State& state)
+{
+    const auto& tasks = Tasks(state.range(0));
+    for (auto _ : state)
+    {
+        KeywordIndex index;
+        for (const auto& task : tasks)
+            index.Add(task.GetId(), task.GetDescription());
+        benchmark::DoNotOptimize(index.TermCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IndexBuild)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+// Query an existing index; range(1) selects the query
+static void BM_IndexQuery(benchmark::State& state)
+{
+    const auto& index = Index(state.range(0));
+    const char* query = QUERIES[state.range(1)];
+    for (auto _ : state)
+    {
+        auto ids = index.Query(query);
+        benchmark::DoNotOptimize(ids.data());
+    }
+    state.SetLabel(query);
+}
+BENCHMARK(BM_IndexQuery)->ArgsProduct({{100'000, 1'000'000}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMillisecond);
+
+// The linear scan the index replaces
+static void BM_LinearScan(benchmark::State& state)
+{
+    const auto& tasks = Tasks(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<int> ids;
+        for (const auto& task : tasks)
+        {
+            if (task.GetDescription().find("parser") != std::string_view::npos)
+                ids.push_back(task.GetId());
+        }
+        benchmark::DoNotOptimize(ids.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LinearScan)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+// Substring scan over packed descriptions; range(1) is the Isa, range(2)
+// ignoreCase. Compare with BM_LinearScan, std::string_view::find per task
+static void BM_CorpusScan(benchmark::State& state)
+{
+    const auto isa = static_cast<SubstringScan::Isa>(state.range(1));
+    if (isa > SubstringScan::Detected())
+    {
+        state.SkipWithError("Instruction set not supported");
+        return;
+    }
+
+    SubstringScan::Corpus corpus;
+    for (const auto& task : Tasks(state.range(0)))
+        corpus.Add(task.GetDescription());
+
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        corpus.FindAll("parser", state.range(2) != 0, [&](size_t) { ++hits; }, isa);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CorpusScan)->ArgsProduct({{100'000, 1'000'000}, {0, 1, 2}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// A fragment that never matches, so the scan is pure filtering
+static void BM_CorpusScanMiss(benchmark::State& state)
+{
+    const auto isa = static_cast<SubstringScan::Isa>(state.range(1));
+    if (isa > SubstringScan::Detected())
+    {
+        state.SkipWithError("Instruction set not supported");
+        return;
+    }
+
+    SubstringScan::Corpus corpus;
+    size_t bytes = 0;
+    for (const auto& task : Tasks(state.range(0)))
+    {
+        corpus.Add(task.GetDescription());
+        bytes += task.GetDescription().size() + 1;
+    }
+
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        corpus.FindAll("xyzzy", true, [&](size_t) { ++hits; }, isa);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_CorpusScanMiss)->ArgsProduct({{1'000'000}, {0, 1, 2}})
+    ->Unit(benchmark::kMillisecond);
+
+// std::string_view::find per description for the missing fragment
+static void BM_LinearScanMiss(benchmark::State& state)
+{
+    const auto& tasks = Tasks(state.range(0));
+    for (auto _ : state)
+    {
+        size_t hits = 0;
+        for (const auto& task : tasks)
+            hits += task.GetDescription().find("xyzzy") != std::string_view::npos;
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LinearScanMiss)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
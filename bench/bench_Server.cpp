@@ -0,0 +1,99 @@
+#include "BenchUtil.h"
+#include "../src/Server.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr size_t STORE_SIZE = 10'000;
+
+    // One server for the whole run, on a scratch copy of the store
+    struct Fixture
+    {
+        std::filesystem::path socketPath = std::filesystem::temp_directory_path() / "bench-task-tracker.sock";
+        std::optional<TaskList> tasks;
+        std::optional<TaskServer> server;
+        std::thread thread;
+
+        Fixture()
+        {
+            auto path = std::filesystem::temp_directory_path() / "bench-task-tracker-server.json";
+            auto journal = path;
+            journal += ".journal";
+            std::filesystem::remove(journal);
+            std::filesystem::copy_file(bench::SyntheticStore(STORE_SIZE), path,
+                std::filesystem::copy_options::overwrite_existing);
+
+            TaskListOptions options;
+            options.persistence = TaskListOptions::Persistence::JOURNAL;
+            tasks.emplace(path, options);
+            TaskServer::Options serverOptions;
+            serverOptions.socketPath = socketPath;
+            server.emplace(*tasks, serverOptions);
+            thread = std::thread([this] { server->Run(); });
+            server->WaitReady();
+        }
+
+        ~Fixture()
+        {
+            server->Stop();
+            thread.join();
+        }
+    };
+
+    Fixture& Server()
+    {
+        static Fixture fixture;
+        return fixture;
+    }
+
+    // Round trips of one connection, with latency percentiles as counters
+    template <typename NextLine>
+    void RoundTrips(benchmark::State& state, NextLine nextLine)
+    {
+        TaskClient client;
+        if (!client.Connect(Server().socketPath))
+        {
+            state.SkipWithError("no server");
+            return;
+        }
+
+        std::vector<double> latencies;
+        for (auto _ : state)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto response = client.Send(nextLine());
+            auto stop = std::chrono::steady_clock::now();
+            if (!response || !response->ok)
+            {
+                state.SkipWithError("request failed");
+                return;
+            }
+            latencies.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+        state.counters["p50_us"] = percentile(0.50);
+        state.counters["p99_us"] = percentile(0.99);
+    }
+}
+
+static void BM_ServerMark(benchmark::State& state)
+{
+    size_t i = 0;
+    RoundTrips(state, [&] {
+        ++i;
+        return (i % 2 ? "mark-done " : "mark-in-progress ") + std::to_string(i % STORE_SIZE + 1);
+    });
+}
+BENCHMARK(BM_ServerMark)->Unit(benchmark::kMicrosecond);
+
+static void BM_ServerSearch(benchmark::State& state)
+{
+    RoundTrips(state, [] { return std::string("search deploy 4242"); });
+}
+BENCHMARK(BM_ServerSearch)->Unit(benchmark::kMicrosecond);
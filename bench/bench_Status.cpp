@@ -0,0 +1,97 @@
+#include "BenchUtil.h"
+#include "../src/TaskList.h"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    // 1M tasks, 1% IN_PROGRESS, half of the rest DONE
+    std::filesystem::path StatusStore()
+    {
+        constexpr size_t COUNT = 1'000'000;
+        auto path = std::filesystem::temp_directory_path() / "bench-task-tracker-status.json";
+        if (std::filesystem::exists(path))
+            return path;
+
+        std::vector<Task> tasks;
+        TaskList::ParseTasks(bench::ReadFile(bench::SyntheticStore(COUNT)), tasks);
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            auto status = i % 100 == 0 ? Task::Status::IN_PROGRESS
+                : i % 2 ? Task::Status::DONE : Task::Status::TODO;
+            tasks[i].MarkTask(status, tasks[i].GetCreatedAt());
+        }
+        TaskList::WriteTasks(tasks, path);
+        return path;
+    }
+
+    TaskList& Store()
+    {
+        // Journal mode without mutations never writes the store back
+        static TaskList list = [] {
+            TaskListOptions options;
+            options.persistence = TaskListOptions::Persistence::JOURNAL;
+            return TaskList(StatusStore(), options);
+        }();
+        return list;
+    }
+}
+
+// List the 1% through the status index
+static void BM_GetByStatusIndexed(benchmark::State& state)
+{
+    const TaskList& list = Store();
+    for (auto _ : state)
+    {
+        auto view = list.GetByStatus(Task::Status::IN_PROGRESS);
+        benchmark::DoNotOptimize(view.size());
+    }
+}
+BENCHMARK(BM_GetByStatusIndexed)->Unit(benchmark::kMicrosecond);
+
+// The linear scan GetByStatus did before
+static void BM_GetByStatusScan(benchmark::State& state)
+{
+    static const std::vector<Task> tasks = [] {
+        std::vector<Task> out;
+        TaskList::ParseTasks(bench::ReadFile(StatusStore()), out);
+        return out;
+    }();
+    for (auto _ : state)
+    {
+        std::vector<const Task*> out;
+        for (const Task& task : tasks)
+        {
+            if (task.GetStatus() == Task::Status::IN_PROGRESS)
+                out.push_back(&task);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_GetByStatusScan)->Unit(benchmark::kMicrosecond);
+
+static void BM_CountByStatus(benchmark::State& state)
+{
+    const TaskList& list = Store();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(list.CountByStatus(Task::Status::IN_PROGRESS));
+}
+BENCHMARK(BM_CountByStatus);
+
+// Remove the oldest task and add a new one, so the store keeps its size.
+// Used to be an O(n) vector::erase per removal.
+static void BM_RemoveAndAddById(benchmark::State& state)
+{
+    // Rewritten to a scratch copy on exit, the shared store stays untouched
+    static TaskList list = [] {
+        auto path = std::filesystem::temp_directory_path() / "bench-task-tracker-mutate.json";
+        std::filesystem::copy_file(StatusStore(), path, std::filesystem::copy_options::overwrite_existing);
+        return TaskList(path);
+    }();
+    static int oldest = 1;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.RemoveTask(oldest++));
+        benchmark::DoNotOptimize(list.AddTask("Benchmark task"));
+    }
+}
+BENCHMARK(BM_RemoveAndAddById)->Unit(benchmark::kMicrosecond);
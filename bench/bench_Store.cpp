@@ -0,0 +1,132 @@
+#include "BenchUtil.h"
+#include "../src/TaskList.h"
+#include <benchmark/benchmark.h>
+#include <sstream>
+
+// Load, save, status queries and Task::ToJson on stores shaped like
+// production ones. Args: task count, shape (index into Shapes()).
+namespace
+{
+    struct Shape
+    {
+        const char* name;
+        bench::StoreSpec spec;
+    };
+
+    const std::vector<Shape>& Shapes()
+    {
+        static const std::vector<Shape> shapes = [] {
+            std::vector<Shape> out;
+            out.push_back({"uniform", {}});
+            // Descriptions of a few sentences, some pasted logs
+            bench::StoreSpec longDesc;
+            longDesc.minWords = 10;
+            longDesc.maxWords = 40;
+            longDesc.longPercent = 2;
+            longDesc.longWords = 300;
+            out.push_back({"long", longDesc});
+            // An old store: most tasks done, a few in progress
+            bench::StoreSpec aged;
+            aged.statusWeights = {10, 2, 88};
+            out.push_back({"aged", aged});
+            return out;
+        }();
+        return shapes;
+    }
+
+    std::filesystem::path StorePath(const benchmark::State& state)
+    {
+        bench::StoreSpec spec = Shapes()[state.range(1)].spec;
+        spec.count = state.range(0);
+        return bench::SyntheticStore(spec);
+    }
+
+    // Journal mode without mutations never writes the store back
+    TaskListOptions ReadOnly()
+    {
+        TaskListOptions options;
+        options.persistence = TaskListOptions::Persistence::JOURNAL;
+        options.durable = false;
+        return options;
+    }
+
+    void ShapeArgs(benchmark::internal::Benchmark* b)
+    {
+        for (int64_t count : {100'000, 1'000'000})
+        {
+            for (size_t shape = 0; shape < Shapes().size(); ++shape)
+                b->Args({count, static_cast<int64_t>(shape)});
+        }
+        b->ArgNames({"tasks", "shape"})->Unit(benchmark::kMillisecond);
+    }
+}
+
+// Macro: the TaskList constructor, i.e. lock, map, LoadFromFile and indexes
+static void BM_StoreLoad(benchmark::State& state)
+{
+    const auto path = StorePath(state);
+    state.SetLabel(Shapes()[state.range(1)].name);
+    for (auto _ : state)
+    {
+        TaskList tasks(path, ReadOnly());
+        benchmark::DoNotOptimize(tasks.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path)));
+}
+BENCHMARK(BM_StoreLoad)->Apply(ShapeArgs);
+
+// Macro: SaveAs, i.e. WriteVectorToFile into a temp file and the rename
+static void BM_StoreSave(benchmark::State& state)
+{
+    const auto path = StorePath(state);
+    const auto out = std::filesystem::temp_directory_path() / "bench-task-tracker-store-save.json";
+    state.SetLabel(Shapes()[state.range(1)].name);
+    TaskList tasks(path, ReadOnly());
+    for (auto _ : state)
+    {
+        bool ok = tasks.SaveAs(out, TaskListOptions::Format::JSON);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(out)));
+    std::filesystem::remove(out);
+}
+BENCHMARK(BM_StoreSave)->Apply(ShapeArgs);
+
+// Micro: GetByStatus for every status, the view and a walk over it
+static void BM_StoreGetByStatus(benchmark::State& state)
+{
+    TaskList tasks(StorePath(state), ReadOnly());
+    state.SetLabel(Shapes()[state.range(1)].name);
+    for (auto _ : state)
+    {
+        for (auto status : {Task::Status::TODO, Task::Status::IN_PROGRESS, Task::Status::DONE})
+        {
+            size_t length = 0;
+            for (const Task& task : tasks.GetByStatus(status))
+                length += task.GetDescription().size();
+            benchmark::DoNotOptimize(length);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StoreGetByStatus)->Apply(ShapeArgs);
+
+// Micro: Task::ToJson of every task into one stream
+static void BM_StoreTaskToJson(benchmark::State& state)
+{
+    std::vector<Task> tasks;
+    TaskList::ParseTasks(bench::ReadFile(StorePath(state)), tasks);
+    state.SetLabel(Shapes()[state.range(1)].name);
+    std::ostringstream out;
+    for (auto _ : state)
+    {
+        out.str({});
+        for (const Task& task : tasks)
+            task.ToJson(out);
+        benchmark::DoNotOptimize(out.tellp());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StoreTaskToJson)->Apply(ShapeArgs);
@@ -0,0 +1,93 @@
+#include "../src/TimeCodec.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Timestamps spread over a year, like a store that grew over time
+static std::vector<std::chrono::system_clock::time_point> SampleTimes()
+{
+    std::vector<std::chrono::system_clock::time_point> times;
+    for (int i = 0; i < 4096; ++i)
+        times.push_back(std::chrono::system_clock::from_time_t(1735689600 + i * 7717));
+    return times;
+}
+
+static std::vector<std::string> SampleTexts()
+{
+    std::vector<std::string> texts;
+    char buf[TimeCodec::TIMESTAMP_SIZE];
+    for (auto tp : SampleTimes())
+    {
+        TimeCodec::Format(tp, buf);
+        texts.emplace_back(buf, sizeof(buf));
+    }
+    return texts;
+}
+
+// Previous formatter: localtime_r + put_time into an ostringstream
+static void BM_FormatPutTime(benchmark::State& state)
+{
+    auto times = SampleTimes();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        std::time_t t = std::chrono::system_clock::to_time_t(times[i++ & 4095]);
+        std::tm tm;
+        localtime_r(&t, &tm);
+        std::ostringstream oss;
+        oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+        benchmark::DoNotOptimize(oss.str());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatPutTime);
+
+static void BM_FormatCodec(benchmark::State& state)
+{
+    auto times = SampleTimes();
+    char buf[TimeCodec::TIMESTAMP_SIZE];
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        TimeCodec::Format(times[i++ & 4095], buf);
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatCodec);
+
+// Previous parser: istringstream + get_time + mktime + now()
+static void BM_ParseGetTime(benchmark::State& state)
+{
+    auto texts = SampleTexts();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        std::tm tm = {};
+        std::istringstream ss(texts[i++ & 4095]);
+        ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+        tm.tm_isdst = -1;
+        auto parsed = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+        auto now = std::chrono::system_clock::now();
+        benchmark::DoNotOptimize(parsed > now);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseGetTime);
+
+static void BM_ParseCodec(benchmark::State& state)
+{
+    auto texts = SampleTexts();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        auto parsed = TimeCodec::Parse(texts[i++ & 4095]);
+        benchmark::DoNotOptimize(parsed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseCodec);
@@ -1,322 +1,36 @@
+#include "src/Command.h"
+#include "src/Server.h"
 #include "src/TaskList.h"
 
-#include <algorithm>
-#include <cctype>
-#include <cstddef>
+#include <chrono>
+#include <csignal>
 #include <cstdlib>
-#include <cstring>
-#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <optional>
-#include <stdexcept>
 #include <string>
+#include <string_view>
 
-// Structs
-struct Command 
-{
-    enum class Type 
-    {
-        LIST, ADD, DELETE, MARK_IN_PROGRESS, MARK_DONE, UPDATE, INVALID
-    };
-    Type type;
-    std::string description;
-    std::optional<size_t> taskIndex;
-    std::string filter;
-};
-
-// Forward declarations
-std::optional<Command> ParseArguments(int argc, char* argv[]);
-bool ExecuteCommand(const Command& cmd, TaskList& tasks);
-std::optional<size_t> ParseTaskIndex(char const* userInput);
 void PrintUsage(const char* progName);
+std::optional<BatchResult> RunBatchInput(const Command& command, 
+    const std::function<BatchResult(std::istream&)>& run);
+int ReportBatch(const std::optional<BatchResult>& result);
+int ForwardCommand(const Command& command, TaskClient& client, int argc, char* argv[]);
 
-
-std::optional<Command> ParseArguments(int argc, char* argv[])
+namespace
 {
-    // Input Validation
-    if (argc <= 0 || argv == nullptr || argv[1] == nullptr)
-    {
-        std::cerr << "Error: invalid arguments" << std::endl;
-        return std::nullopt;
-    }
-    
-    if (argc == 1)
-    {
-        std::cerr << "Error: no arguments" << std::endl;
-        return std::nullopt;
-    }
-
-    // Command Recognition && Argument Count Validation
-    std::string arg1 = argv[1];
-    std::transform(arg1.begin(), arg1.end(), arg1.begin(),
-    [](unsigned char c) { return std::tolower(c); });
-    Command command = {};
-    
-    if (arg1 == "list")
-    {
-        if (argc != 2 && argc != 3)
-        {
-            std::cerr << "Error: wrong number of arguments" << std::endl;
-            return std::nullopt;
-        }
-        command.type = Command::Type::LIST;
-        if (argc == 2)
-            return command;
-        else
-        {
-            std::string filter = argv[2];
-            std::transform(
-                filter.begin(), filter.end(), filter.begin(),
-                [](unsigned char c) { return std::tolower(c); }
-            );
-            command.filter = filter;
-            return command;
-        }
-    }
-    else if (arg1 == "add")
-    {   
-        if (argc != 3)
-        {
-            std::cerr << "Error: wrong number of arguments" << std::endl;
-            return std::nullopt;
-        }
-        command.type = Command::Type::ADD;
-        std::string description = argv[2];
-        if (!description.empty())
-        {
-            command.description = description;
-            return command;
-        }
-        else 
-        {
-            std::cerr << "Error: description is empty" << std::endl;
-            return std::nullopt;
-        }
-    }
-    else if (arg1 == "delete")
-    {
-        if (argc != 3)
-        {
-            std::cerr << "Error: wrong number of arguments" << std::endl;
-            return std::nullopt;
-        }
-        command.type = Command::Type::DELETE;
-        std::optional<size_t> userIdx = ParseTaskIndex(argv[2]);
-        
-        if (userIdx)
-        {
-            command.taskIndex = userIdx;
-            return command;
-        }
-        else 
-        {
-            return std::nullopt;
-        }
-    }
-    else if (arg1 == "update")
-    {
-        if (argc != 4)
-        {
-            std::cerr << "Error: wrong number of arguments" << std::endl;
-            return std::nullopt;
-        }
-        command.type = Command::Type::UPDATE;
+    TaskServer* g_server = nullptr;
+    constexpr std::chrono::milliseconds SERVE_SYNC_INTERVAL{50};
 
-        std::optional<size_t> userIdx = ParseTaskIndex(argv[2]);
-        if (!userIdx)
-        {
-            std::cerr << "Error: index is invalid index format" << std::endl;
-            return std::nullopt;
-        } 
-        command.taskIndex = userIdx;
-        std::string description = argv[3];
-        if (!description.empty())
-        {
-            command.description = description;
-            return command;
-        }
-        else 
-        {
-            std::cerr << "Error: description is empty" << std::endl;
-            return std::nullopt;
-        }
-    }
-    else if (arg1 == "mark-in-progress")
+    extern "C" void StopServer(int)
     {
-        if (argc != 3)
-        {
-            std::cerr << "Error: wrong number of arguments" << std::endl;
-            return std::nullopt;
-        }
-        command.type = Command::Type::MARK_IN_PROGRESS;
-        std::optional<size_t> userIdx = ParseTaskIndex(argv[2]);
-        if (userIdx)
-        {
-            command.taskIndex = userIdx;
-            return command;
-        }
-        else 
-        {
-            return std::nullopt;
-        }
-    }
-    else if (arg1 == "mark-done")
-    {
-        if (argc != 3)
-        {
-            std::cerr << "Error: wrong number of arguments" << std::endl;
-            return std::nullopt;
-        }
-        command.type = Command::Type::MARK_DONE;
-        std::optional<size_t> userIdx = ParseTaskIndex(argv[2]);
-        if (userIdx)
-        {
-            command.taskIndex = userIdx;
-            return command;
-        }
-        else 
-        {
-            return std::nullopt;
-        }
-    }
-    else
-    {
-        command.type = Command::Type::INVALID;
-        std::cerr << "Error: unknown or invalid command" << std::endl;
-        return std::nullopt;
-    }
-}
-
-bool ExecuteCommand(const Command& cmd, TaskList& tasks)
-{
-    switch (cmd.type) {
-        case Command::Type::LIST:
-            if (cmd.filter.empty())
-            {
-                tasks.PrintAllTasks();
-                return true;
-            }
-            else 
-            {
-                if (!tasks.ListTasks(cmd.filter)) 
-                {
-                    std::cerr << "Error: Could not list tasks with filter '" 
-                        << cmd.filter << "'" << std::endl;
-                    return false;
-                }
-                return true;
-            }
-            
-        case Command::Type::ADD:
-            if (!tasks.AddTask(cmd.description)) 
-            {
-                std::cerr << "Error: Could not add task '" << cmd.description 
-                    << "'" << std::endl;
-                return false;
-            }
-            return true;
-            
-        case Command::Type::UPDATE:
-            if (*cmd.taskIndex >= tasks.Size()) 
-            {
-                std::cerr << "Error: Task index " << (*cmd.taskIndex + 1) 
-                    << " out of range (valid: 1..." << tasks.Size() << ")" 
-                    << std::endl;
-                return false;
-            }
-            if (!tasks.UpdateTask(*cmd.taskIndex, cmd.description)) 
-            {
-                std::cerr << "Error: Could not update task " 
-                    << (*cmd.taskIndex + 1) << std::endl;
-                return false;
-            }
-            return true;
-            
-        case Command::Type::DELETE:
-            if (*cmd.taskIndex >= tasks.Size()) 
-            {
-                std::cerr << "Error: Task index " << (*cmd.taskIndex + 1) 
-                    << " out of range (valid: 1..." << tasks.Size() << ")" 
-                    << std::endl;
-                return false;
-            }
-            if (!tasks.RemoveTask(*cmd.taskIndex)) 
-            {
-                std::cerr << "Error: Could not delete task " 
-                    << (*cmd.taskIndex + 1) << std::endl;
-                return false;
-            }
-            return true;
-            
-        case Command::Type::MARK_DONE:
-            if (*cmd.taskIndex >= tasks.Size()) 
-            {
-                std::cerr << "Error: Task index " << (*cmd.taskIndex + 1) 
-                    << " out of range (valid: 1..." << tasks.Size() << ")" 
-                    << std::endl;
-                return false;
-            }
-            if (!tasks.MarkTask(*cmd.taskIndex, Task::Status::DONE)) 
-            {
-                std::cerr << "Error: Could not mark task " 
-                    << (*cmd.taskIndex + 1) << " as done" << std::endl;
-                return false;
-            }
-            return true;
-            
-        case Command::Type::MARK_IN_PROGRESS:
-            if (*cmd.taskIndex >= tasks.Size()) 
-            {
-                std::cerr << "Error: Task index " << (*cmd.taskIndex + 1) 
-                    << " out of range (valid: 1..." << tasks.Size() << ")" 
-                    << std::endl;
-                return false;
-            }
-            if (!tasks.MarkTask(*cmd.taskIndex, Task::Status::IN_PROGRESS)) 
-            {
-                std::cerr << "Error: Could not mark task " 
-                    << (*cmd.taskIndex + 1) << " as in-progress" << std::endl;
-                return false;
-            }
-            return true;
-            
-        case Command::Type::INVALID:
-            std::cerr << "Error: Invalid command type" << std::endl;
-            return false;
-            
-        default:
-            std::cerr << "Error: Unknown command type" << std::endl;
-            return false;
+        if (g_server)
+            g_server->Stop();
     }
 }
 
-std::optional<size_t> ParseTaskIndex(char const* userInput)
-{
-    unsigned long userIdx = 0;
-    try {
-        size_t pos = 0;
-        userIdx = std::stoul(userInput, &pos);
-        if (pos != std::strlen(userInput))
-        {
-            throw std::invalid_argument{"Extra characters"};
-        }
-    } 
-    catch (const std::exception&)
-    {
-        std::cerr << "Error: " << userInput
-            << " is not a valid positive integer\n";
-            return std::nullopt;
-    }
-
-    if (userIdx == 0)
-    {
-        std::cerr << "Error: Task with index 0 does not exist" << std::endl; 
-        return std::nullopt;
-    }
-
-    return static_cast<size_t>(userIdx-1);
-}
 void PrintUsage(const char* progName)
 {
     // Extract just the filename from the full path
@@ -332,20 +46,129 @@ void PrintUsage(const char* progName)
     << "  mark-in-progress <id>                 Mark task as in-progress\n"
     << "  mark-done <id>                        Mark task as done\n"
     << "  list [status]                         List tasks (optional status: "
-    << "todo, in-progress, done)\n\n";
+    << "todo, in-progress, done)\n"
+    << "    [--sort id|created|updated]         Order by id, or newest first\n"
+    << "    [--limit N] [--offset M]            Print only N tasks after skipping M\n"
+    << "    [--format text|table|jsonl|tsv]     Output format, text by default\n"
+    << "  search <terms>                        Search descriptions (terms are "
+    << "ANDed, OR between alternatives, prefix*, *infix*)\n"
+    << "  batch [file]                          Run one command per line from "
+    << "file or stdin, loading and saving once\n"
+    << "  flush                                 Write pending changes to the store\n"
+    << "  serve [flush-seconds]                 Keep the store in memory and serve "
+    << "the commands above over a local socket\n\n"
+    << "While a server runs, commands are sent to it "
+    << "(socket: $TASK_CLI_SOCKET or " << TaskProtocol::DefaultSocketPath().string() << ").\n";
+}
+
+std::optional<BatchResult> RunBatchInput(const Command& command, 
+    const std::function<BatchResult(std::istream&)>& run)
+{
+    if (command.input.empty() || command.input == "-")
+        return run(std::cin);
+
+    std::ifstream in(command.input);
+    if (!in)
+    {
+        std::cerr << "Error: could not open " << command.input << std::endl;
+        return std::nullopt;
+    }
+    return run(in);
+}
+
+int ReportBatch(const std::optional<BatchResult>& result)
+{
+    if (!result)
+        return EXIT_FAILURE;
+    std::cerr << result->commands << " commands, " << result->failed 
+        << " failed" << std::endl;
+    return result->failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int ForwardCommand(const Command& command, TaskClient& client, int argc, char* argv[])
+{
+    auto send = [&client](std::string_view line)
+    {
+        auto response = client.Send(line);
+        if (!response)
+        {
+            std::cerr << "Error: lost connection to the server" << std::endl;
+            return false;
+        }
+        (response->ok ? std::cout : std::cerr) << response->output << std::flush;
+        return response->ok;
+    };
+
+    if (command.type == Command::Type::BATCH)
+    {
+        return ReportBatch(RunBatchInput(command, [&](std::istream& in) {
+            return RunBatch(in, std::cerr, send);
+        }));
+    }
+    return send(FormatCommandLine(argc - 1, argv + 1)) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 int main(int argc, char *argv[])
 {
+    // Listings go out in large chunks, nothing here writes through stdio
+    std::ios::sync_with_stdio(false);
+
     auto command = ParseArguments(argc, argv);
     if (!command)
     {
         PrintUsage(argv[0]);
         return EXIT_FAILURE;
     }
+
+    // A running server owns the store, hand the command over
+    if (command->type != Command::Type::SERVE)
+    {
+        TaskClient client;
+        if (client.Connect())
+            return ForwardCommand(*command, client, argc, argv);
+    }
     
     // Create TaskList to get data
-    auto tasks = TaskList("task-tracker.json");
+    // Mutations are journaled, the store itself is only rewritten on compaction
+    TaskListOptions options;
+    options.persistence = TaskListOptions::Persistence::JOURNAL;
+    // A batch is synced in groups and once at its end, not per command
+    if (command->type == Command::Type::BATCH)
+        options.groupCommit = 256;
+    // The server answers mutations before their fsync; records are synced
+    // in groups of 64 or every SERVE_SYNC_INTERVAL, whatever comes first,
+    // so a crash loses at most that much
+    if (command->type == Command::Type::SERVE)
+        options.groupCommit = 64;
+    // Commands addressing single tasks only decode those
+    options.lazy = command->type == Command::Type::ADD 
+        || command->type == Command::Type::UPDATE
+        || command->type == Command::Type::DELETE
+        || command->type == Command::Type::MARK_DONE
+        || command->type == Command::Type::MARK_IN_PROGRESS;
+    auto tasks = TaskList("task-tracker.json", options);
+
+    if (command->type == Command::Type::SERVE)
+    {
+        TaskServer::Options serverOptions;
+        serverOptions.flushInterval = std::chrono::seconds(command->flushSeconds);
+        serverOptions.syncInterval = SERVE_SYNC_INTERVAL;
+        TaskServer server(tasks, serverOptions);
+        g_server = &server;
+        std::signal(SIGINT, StopServer);
+        std::signal(SIGTERM, StopServer);
+        bool served = server.Run();
+        g_server = nullptr;
+        return served ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (command->type == Command::Type::BATCH)
+    {
+        return ReportBatch(RunBatchInput(*command, [&tasks](std::istream& in) {
+            return RunBatch(in, tasks, std::cerr);
+        }));
+    }
+
     return ExecuteCommand(*command, tasks)
         ? EXIT_SUCCESS : EXIT_FAILURE;
 }
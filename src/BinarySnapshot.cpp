@@ -0,0 +1,255 @@
+#include "BinarySnapshot.h"
+#include "FileIO.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+    namespace chrono = std::chrono;
+
+    constexpr char MAGIC[8] = {'T', 'T', 'S', 'N', 'A', 'P', '\r', '\n'};
+    constexpr size_t HEADER_SIZE = 40;
+    constexpr size_t RECORD_SIZE = 32;
+    constexpr uint8_t FLAG_HAS_UPDATED_AT = 1;
+
+    // Header field offsets
+    constexpr size_t H_VERSION = 8, H_NEXT_ID = 12, H_COUNT = 16, H_HEAP = 24, H_CHECKSUM = 32;
+    // Record field offsets
+    constexpr size_t R_CREATED = 0, R_UPDATED = 8, R_ID = 16, R_OFFSET = 20,
+                     R_LENGTH = 24, R_STATUS = 28, R_FLAGS = 29;
+
+    template <typename T>
+    T ByteSwap(T value) noexcept
+    {
+        T out = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            out = static_cast<T>((out << 8) | (value & 0xFF));
+            value = static_cast<T>(value >> 8);
+        }
+        return out;
+    }
+
+    template <typename T>
+    T Load(const char* p) noexcept
+    {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big)
+            value = ByteSwap(value);
+        return value;
+    }
+
+    template <typename T>
+    void Store(char* p, T value) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::big)
+            value = ByteSwap(value);
+        std::memcpy(p, &value, sizeof(T));
+    }
+
+    // Four independent multiply-rotate lanes so the hash keeps up with
+    // memory bandwidth; same round function as xxHash64.
+    uint64_t Checksum(std::string_view data) noexcept
+    {
+        constexpr uint64_t P1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+        auto round = [](uint64_t acc, uint64_t word) {
+            return std::rotl(acc + word * P2, 31) * P1;
+        };
+
+        const char* p = data.data();
+        const char* end = p + data.size();
+        uint64_t lanes[4] = {P1 + P2, P2, 0, 0 - P1};
+        while (end - p >= 32)
+        {
+            for (int i = 0; i < 4; ++i)
+                lanes[i] = round(lanes[i], Load<uint64_t>(p + 8 * i));
+            p += 32;
+        }
+
+        uint64_t h = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7)
+            + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+        h += data.size();
+        while (end - p >= 8)
+        {
+            h = std::rotl(h ^ round(0, Load<uint64_t>(p)), 27) * P1;
+            p += 8;
+        }
+        while (p < end)
+        {
+            h = std::rotl(h ^ (static_cast<unsigned char>(*p++) * P1), 11) * P2;
+        }
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        return h;
+    }
+
+    int64_t ToNanos(chrono::system_clock::time_point tp) noexcept
+    {
+        return chrono::duration_cast<chrono::nanoseconds>(tp.time_since_epoch()).count();
+    }
+
+    chrono::system_clock::time_point FromNanos(int64_t ns) noexcept
+    {
+        return chrono::system_clock::time_point(
+            chrono::duration_cast<chrono::system_clock::duration>(chrono::nanoseconds(ns)));
+    }
+}
+
+bool BinarySnapshot::IsBinary(std::string_view data) noexcept
+{
+    return data.size() >= sizeof(MAGIC)
+        && std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+int BinarySnapshot::NextId(std::string_view data) noexcept
+{
+    if (data.size() < HEADER_SIZE || !IsBinary(data))
+        return 0;
+    return std::max(Load<int32_t>(data.data() + H_NEXT_ID), 0);
+}
+
+bool BinarySnapshot::Read(std::string_view data, std::vector<Task>& out)
+{
+    if (data.size() < HEADER_SIZE || !IsBinary(data))
+    {
+        std::cerr << "Error: Not a binary task snapshot\n";
+        return false;
+    }
+
+    const char* header = data.data();
+    uint32_t version = Load<uint32_t>(header + H_VERSION);
+    if (version != VERSION)
+    {
+        std::cerr << "Error: Unsupported snapshot version " << version << "\n";
+        return false;
+    }
+
+    uint64_t count = Load<uint64_t>(header + H_COUNT);
+    uint64_t heapSize = Load<uint64_t>(header + H_HEAP);
+    uint64_t payload = data.size() - HEADER_SIZE;
+    if (count > payload / RECORD_SIZE || heapSize != payload - count * RECORD_SIZE)
+    {
+        std::cerr << "Error: Snapshot size does not match its header\n";
+        return false;
+    }
+
+    if (Checksum(data.substr(HEADER_SIZE)) != Load<uint64_t>(header + H_CHECKSUM))
+    {
+        std::cerr << "Error: Snapshot checksum mismatch\n";
+        return false;
+    }
+
+    const char* records = data.data() + HEADER_SIZE;
+    const std::string_view heap = data.substr(HEADER_SIZE + count * RECORD_SIZE);
+    out.reserve(out.size() + count);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        const char* r = records + i * RECORD_SIZE;
+        uint32_t offset = Load<uint32_t>(r + R_OFFSET);
+        uint32_t length = Load<uint32_t>(r + R_LENGTH);
+        uint8_t status = Load<uint8_t>(r + R_STATUS);
+        uint8_t flags = Load<uint8_t>(r + R_FLAGS);
+        if (static_cast<uint64_t>(offset) + length > heap.size() || status > 2)
+        {
+            std::cerr << "Error: Invalid record " << i << " in snapshot\n";
+            return false;
+        }
+
+        std::optional<chrono::system_clock::time_point> updatedAt;
+        if (flags & FLAG_HAS_UPDATED_AT)
+            updatedAt = FromNanos(Load<int64_t>(r + R_UPDATED));
+
+        out.push_back(Task::Borrowing(Load<int32_t>(r + R_ID),
+            heap.substr(offset, length), static_cast<Task::Status>(status),
+            FromNanos(Load<int64_t>(r + R_CREATED)), updatedAt));
+    }
+    return true;
+}
+
+bool BinarySnapshot::Encode(const std::vector<Task>& tasks, std::string& out, int nextId)
+{
+    uint64_t heapSize = 0;
+    for (const auto& task : tasks)
+        heapSize += task.GetDescription().size();
+    if (heapSize > std::numeric_limits<uint32_t>::max())
+    {
+        std::cerr << "Error: Descriptions exceed the 4 GiB snapshot heap\n";
+        return false;
+    }
+
+    const size_t recordsSize = tasks.size() * RECORD_SIZE;
+    out.assign(HEADER_SIZE + recordsSize + heapSize, '\0');
+
+    char* header = out.data();
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    Store<uint32_t>(header + H_VERSION, VERSION);
+    Store<int32_t>(header + H_NEXT_ID, nextId);
+    Store<uint64_t>(header + H_COUNT, tasks.size());
+    Store<uint64_t>(header + H_HEAP, heapSize);
+
+    char* r = out.data() + HEADER_SIZE;
+    char* heap = r + recordsSize;
+    uint32_t offset = 0;
+    for (const auto& task : tasks)
+    {
+        auto desc = task.GetDescription();
+        auto updatedAt = task.GetUpdatedAt();
+        Store<int64_t>(r + R_CREATED, ToNanos(task.GetCreatedAt()));
+        Store<int64_t>(r + R_UPDATED, updatedAt ? ToNanos(*updatedAt) : 0);
+        Store<int32_t>(r + R_ID, task.GetId());
+        Store<uint32_t>(r + R_OFFSET, offset);
+        Store<uint32_t>(r + R_LENGTH, static_cast<uint32_t>(desc.size()));
+        Store<uint8_t>(r + R_STATUS, static_cast<uint8_t>(task.GetStatus()));
+        Store<uint8_t>(r + R_FLAGS, updatedAt ? FLAG_HAS_UPDATED_AT : 0);
+
+        std::memcpy(heap + offset, desc.data(), desc.size());
+        offset += static_cast<uint32_t>(desc.size());
+        r += RECORD_SIZE;
+    }
+
+    Store<uint64_t>(header + H_CHECKSUM,
+        Checksum(std::string_view(out).substr(HEADER_SIZE)));
+    return true;
+}
+
+bool BinarySnapshot::Write(const std::vector<Task>& tasks, const std::filesystem::path& path, bool sync,
+    int nextId)
+{
+    std::string buffer;
+    if (!Encode(tasks, buffer, nextId))
+        return false;
+
+    OutputFile file;
+    if (!file.Open(path, OutputFile::Mode::TRUNCATE))
+    {
+        std::cerr << path << " Could not be opened for writing\n";
+        return false;
+    }
+    if (!file.Write(buffer))
+    {
+        std::cerr << "Error while writing " << path << "\n";
+        file.Close();
+        return false;
+    }
+    if (sync && !file.Sync())
+    {
+        std::cerr << "Error while syncing " << path << "\n";
+        file.Close();
+        return false;
+    }
+    if (!file.Close())
+    {
+        std::cerr << "Error while writing " << path << "\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "Task.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compact binary store format:
+//
+//   Header   magic "TTSNAP\r\n", version, next id, record count, heap size,
+//            checksum
+//   Records  one fixed-width 32 byte record per task (id, status, flags,
+//            created/updated timestamps in ns, description offset/length)
+//   Heap     all descriptions back to back
+//
+// All integers are little-endian. The checksum covers records and heap.
+namespace BinarySnapshot
+{
+    inline constexpr uint32_t VERSION = 1;
+
+    // True if data starts with the snapshot magic
+    bool IsBinary(std::string_view data) noexcept;
+
+    // Decodes a snapshot. Descriptions are borrowed from data, which must
+    // outlive the tasks.
+    bool Read(std::string_view data, std::vector<Task>& out);
+    // Id the next added task gets, 0 if the writer did not store it
+    int NextId(std::string_view data) noexcept;
+
+    // Encodes tasks into out, replacing its content. nextId is kept so ids
+    // of removed tasks are not handed out again; 0 leaves it to the ids.
+    bool Encode(const std::vector<Task>& tasks, std::string& out, int nextId = 0);
+    // With sync, the file is fsynced before it is closed
+    bool Write(const std::vector<Task>& tasks, const std::filesystem::path& path, bool sync = false,
+        int nextId = 0);
+}
@@ -0,0 +1,547 @@
+#include "Command.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+std::optional<Command> ParseArguments(int argc, char* argv[], std::ostream& err)
+{
+    // Input Validation
+    if (argc <= 0 || argv == nullptr || argv[1] == nullptr)
+    {
+        err << "Error: invalid arguments" << std::endl;
+        return std::nullopt;
+    }
+    
+    if (argc == 1)
+    {
+        err << "Error: no arguments" << std::endl;
+        return std::nullopt;
+    }
+
+    // Command Recognition && Argument Count Validation
+    std::string arg1 = argv[1];
+    std::transform(arg1.begin(), arg1.end(), arg1.begin(),
+    [](unsigned char c) { return std::tolower(c); });
+    Command command = {};
+    
+    if (arg1 == "list")
+    {
+        command.type = Command::Type::LIST;
+        for (int i = 2; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            if (!arg.starts_with("--"))
+            {
+                if (!command.filter.empty())
+                {
+                    err << "Error: wrong number of arguments" << std::endl;
+                    return std::nullopt;
+                }
+                std::string filter = argv[i];
+                std::transform(
+                    filter.begin(), filter.end(), filter.begin(),
+                    [](unsigned char c) { return std::tolower(c); }
+                );
+                command.filter = filter;
+                continue;
+            }
+            if (i + 1 == argc)
+            {
+                err << "Error: " << arg << " needs a value" << std::endl;
+                return std::nullopt;
+            }
+            std::string_view value = argv[++i];
+            if (arg == "--format")
+            {
+                auto format = TaskPrinter::ParseFormat(value);
+                if (!format)
+                {
+                    err << "Error: unknown format " << value << std::endl;
+                    return std::nullopt;
+                }
+                command.format = *format;
+                continue;
+            }
+            if (!command.order)
+                command.order.emplace();
+            if (arg == "--sort")
+            {
+                // Timestamps list the newest first
+                if (value == "id")
+                    command.order->key = TaskOrder::Key::ID;
+                else if (value == "created")
+                    command.order->key = TaskOrder::Key::CREATED;
+                else if (value == "updated")
+                    command.order->key = TaskOrder::Key::UPDATED;
+                else
+                {
+                    err << "Error: cannot sort by " << value << std::endl;
+                    return std::nullopt;
+                }
+                command.order->descending = command.order->key != TaskOrder::Key::ID;
+            }
+            else if (arg == "--limit" || arg == "--offset")
+            {
+                size_t count = 0;
+                auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), count);
+                if (ec != std::errc{} || end != value.data() + value.size())
+                {
+                    err << "Error: " << value << " is not a valid count" << std::endl;
+                    return std::nullopt;
+                }
+                (arg == "--limit" ? command.order->limit : command.order->offset) = count;
+            }
+            else
+            {
+                err << "Error: unknown option " << arg << std::endl;
+                return std::nullopt;
+            }
+        }
+        return command;
+    }
+    else if (arg1 == "add")
+    {   
+        if (argc != 3)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::ADD;
+        std::string description = argv[2];
+        if (!description.empty())
+        {
+            command.description = description;
+            return command;
+        }
+        else 
+        {
+            err << "Error: description is empty" << std::endl;
+            return std::nullopt;
+        }
+    }
+    else if (arg1 == "delete")
+    {
+        if (argc != 3)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::DELETE;
+        std::optional<int> userId = ParseTaskId(argv[2], err);
+        
+        if (userId)
+        {
+            command.taskId = userId;
+            return command;
+        }
+        else 
+        {
+            return std::nullopt;
+        }
+    }
+    else if (arg1 == "update")
+    {
+        if (argc != 4)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::UPDATE;
+
+        std::optional<int> userId = ParseTaskId(argv[2], err);
+        if (!userId)
+        {
+            err << "Error: id has an invalid format" << std::endl;
+            return std::nullopt;
+        } 
+        command.taskId = userId;
+        std::string description = argv[3];
+        if (!description.empty())
+        {
+            command.description = description;
+            return command;
+        }
+        else 
+        {
+            err << "Error: description is empty" << std::endl;
+            return std::nullopt;
+        }
+    }
+    else if (arg1 == "mark-in-progress")
+    {
+        if (argc != 3)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::MARK_IN_PROGRESS;
+        std::optional<int> userId = ParseTaskId(argv[2], err);
+        if (userId)
+        {
+            command.taskId = userId;
+            return command;
+        }
+        else 
+        {
+            return std::nullopt;
+        }
+    }
+    else if (arg1 == "mark-done")
+    {
+        if (argc != 3)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::MARK_DONE;
+        std::optional<int> userId = ParseTaskId(argv[2], err);
+        if (userId)
+        {
+            command.taskId = userId;
+            return command;
+        }
+        else 
+        {
+            return std::nullopt;
+        }
+    }
+    else if (arg1 == "search")
+    {
+        if (argc < 3)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::SEARCH;
+        // Unquoted terms arrive as separate arguments
+        for (int i = 2; i < argc; ++i)
+        {
+            if (i > 2)
+                command.filter += ' ';
+            command.filter += argv[i];
+        }
+        return command;
+    }
+    else if (arg1 == "batch")
+    {
+        if (argc != 2 && argc != 3)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::BATCH;
+        if (argc == 3)
+            command.input = argv[2];
+        return command;
+    }
+    else if (arg1 == "flush")
+    {
+        if (argc != 2)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::FLUSH;
+        return command;
+    }
+    else if (arg1 == "serve")
+    {
+        if (argc != 2 && argc != 3)
+        {
+            err << "Error: wrong number of arguments" << std::endl;
+            return std::nullopt;
+        }
+        command.type = Command::Type::SERVE;
+        if (argc == 3)
+        {
+            // Zero turns the periodic flush off
+            std::string_view arg = argv[2];
+            unsigned seconds = 0;
+            auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), seconds);
+            if (ec != std::errc{} || end != arg.data() + arg.size())
+            {
+                err << "Error: " << arg << " is not a valid flush interval" << std::endl;
+                return std::nullopt;
+            }
+            command.flushSeconds = seconds;
+        }
+        return command;
+    }
+    else
+    {
+        command.type = Command::Type::INVALID;
+        err << "Error: unknown or invalid command" << std::endl;
+        return std::nullopt;
+    }
+}
+
+bool ExecuteCommand(const Command& cmd, TaskList& tasks, std::ostream& out, std::ostream& err)
+{
+    switch (cmd.type) {
+        case Command::Type::LIST:
+            // Other formats list in id order unless sorted otherwise
+            if (cmd.order || cmd.format != TaskPrinter::Format::TEXT)
+                return tasks.ListTasks(cmd.filter, cmd.order.value_or(TaskOrder{}), out, cmd.format);
+            if (cmd.filter.empty())
+            {
+                tasks.PrintAllTasks(out);
+                return true;
+            }
+            else 
+            {
+                if (!tasks.ListTasks(cmd.filter, out)) 
+                {
+                    err << "Error: Could not list tasks with filter '" 
+                        << cmd.filter << "'" << std::endl;
+                    return false;
+                }
+                return true;
+            }
+            
+        case Command::Type::ADD:
+            if (!tasks.AddTask(cmd.description, err)) 
+            {
+                err << "Error: Could not add task '" << cmd.description 
+                    << "'" << std::endl;
+                return false;
+            }
+            return true;
+            
+        case Command::Type::UPDATE:
+            if (!tasks.UpdateTask(*cmd.taskId, cmd.description, err)) 
+            {
+                err << "Error: Could not update task " 
+                    << *cmd.taskId << std::endl;
+                return false;
+            }
+            return true;
+            
+        case Command::Type::DELETE:
+            if (!tasks.RemoveTask(*cmd.taskId, err)) 
+            {
+                err << "Error: Could not delete task " 
+                    << *cmd.taskId << std::endl;
+                return false;
+            }
+            return true;
+            
+        case Command::Type::MARK_DONE:
+            if (!tasks.MarkTask(*cmd.taskId, Task::Status::DONE, err)) 
+            {
+                err << "Error: Could not mark task " 
+                    << *cmd.taskId << " as done" << std::endl;
+                return false;
+            }
+            return true;
+            
+        case Command::Type::MARK_IN_PROGRESS:
+            if (!tasks.MarkTask(*cmd.taskId, Task::Status::IN_PROGRESS, err)) 
+            {
+                err << "Error: Could not mark task " 
+                    << *cmd.taskId << " as in-progress" << std::endl;
+                return false;
+            }
+            return true;
+            
+        case Command::Type::SEARCH:
+        {
+            auto found = tasks.FindByKeyWord(cmd.filter);
+            if (found.empty())
+            {
+                out << "No tasks found matching: " << cmd.filter << std::endl;
+                return true;
+            }
+            TaskPrinter printer(out);
+            for (auto const& task : found)
+            {
+                printer.Print(task);
+            }
+            return true;
+        }
+            
+        case Command::Type::FLUSH:
+            if (!tasks.Flush())
+            {
+                err << "Error: Could not write the store" << std::endl;
+                return false;
+            }
+            return true;
+            
+        case Command::Type::BATCH:
+        case Command::Type::SERVE:
+            err << "Error: batch and serve cannot be nested" << std::endl;
+            return false;
+            
+        case Command::Type::INVALID:
+            err << "Error: Invalid command type" << std::endl;
+            return false;
+            
+        default:
+            err << "Error: Unknown command type" << std::endl;
+            return false;
+    }
+}
+
+std::optional<int> ParseTaskId(char const* userInput, std::ostream& err)
+{
+    unsigned long userId = 0;
+    try {
+        size_t pos = 0;
+        userId = std::stoul(userInput, &pos);
+        if (pos != std::strlen(userInput) || userId > INT_MAX)
+        {
+            throw std::invalid_argument{"Extra characters"};
+        }
+    } 
+    catch (const std::exception&)
+    {
+        err << "Error: " << userInput
+            << " is not a valid positive integer\n";
+            return std::nullopt;
+    }
+
+    if (userId == 0)
+    {
+        err << "Error: Task with id 0 does not exist" << std::endl; 
+        return std::nullopt;
+    }
+
+    return static_cast<int>(userId);
+}
+
+bool IsReadOnly(const Command& cmd) noexcept
+{
+    return cmd.type == Command::Type::LIST || cmd.type == Command::Type::SEARCH;
+}
+
+bool SplitCommandLine(std::string_view line, std::vector<std::string>& args)
+{
+    args.clear();
+    size_t i = 0;
+    while (true)
+    {
+        while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i])))
+            ++i;
+        if (i == line.size())
+            return true;
+
+        std::string arg;
+        bool quoted = false;
+        for (; i < line.size(); ++i)
+        {
+            char c = line[i];
+            if (quoted)
+            {
+                if (c == '"')
+                    quoted = false;
+                else if (c == '\\' && i + 1 < line.size() && line[i + 1] == 'n')
+                    arg += '\n', ++i;
+                else if (c == '\\' && i + 1 < line.size()
+                    && (line[i + 1] == '"' || line[i + 1] == '\\'))
+                    arg += line[++i];
+                else
+                    arg += c;
+            }
+            else if (c == '"')
+                quoted = true;
+            else if (std::isspace(static_cast<unsigned char>(c)))
+                break;
+            else
+                arg += c;
+        }
+        if (quoted)
+            return false;
+        args.push_back(std::move(arg));
+    }
+}
+
+std::string FormatCommandLine(int argc, char* argv[])
+{
+    std::string line;
+    for (int i = 0; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        if (i > 0)
+            line += ' ';
+        bool plain = !arg.empty() && std::none_of(arg.begin(), arg.end(), [](unsigned char c) {
+            return std::isspace(c) || c == '"' || c == '\\';
+        });
+        if (plain)
+        {
+            line += arg;
+            continue;
+        }
+        line += '"';
+        for (char c : arg)
+        {
+            if (c == '\n')
+                line += "\\n";
+            else if (c == '"' || c == '\\')
+                line += '\\', line += c;
+            else
+                line += c;
+        }
+        line += '"';
+    }
+    return line;
+}
+
+std::optional<Command> ParseCommandLine(std::string_view line, std::ostream& err)
+{
+    std::vector<std::string> args;
+    if (!SplitCommandLine(line, args))
+    {
+        err << "Error: unterminated quote" << std::endl;
+        return std::nullopt;
+    }
+
+    // ParseArguments expects argv[0] to be the program name
+    static char program[] = "task-cli";
+    std::vector<char*> argv(1, program);
+    for (auto& arg : args)
+        argv.push_back(arg.data());
+    argv.push_back(nullptr);
+    return ParseArguments(static_cast<int>(argv.size() - 1), argv.data(), err);
+}
+
+BatchResult RunBatch(std::istream& in, std::ostream& report, 
+    const std::function<bool(std::string_view line)>& run)
+{
+    BatchResult result;
+    std::string line;
+    for (size_t lineNo = 1; std::getline(in, line); ++lineNo)
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        auto first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+
+        ++result.commands;
+        bool ok = run(line);
+        if (!ok)
+            ++result.failed;
+        report << "line " << lineNo << ": " << (ok ? "ok" : "failed") << '\n';
+    }
+    return result;
+}
+
+BatchResult RunBatch(std::istream& in, TaskList& tasks, std::ostream& report)
+{
+    return RunBatch(in, report, [&tasks](std::string_view line) {
+        auto command = ParseCommandLine(line);
+        return command && ExecuteCommand(*command, tasks);
+    });
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "TaskList.h"
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One parsed task-cli command
+struct Command 
+{
+    enum class Type 
+    {
+        LIST, ADD, DELETE, MARK_IN_PROGRESS, MARK_DONE, UPDATE, SEARCH, FLUSH,
+        BATCH, SERVE, INVALID
+    };
+    Type type;
+    std::string description;
+    std::optional<int> taskId;
+    std::string filter;
+    // LIST with --sort, --limit or --offset
+    std::optional<TaskOrder> order;
+    // LIST --format
+    TaskPrinter::Format format = TaskPrinter::Format::TEXT;
+    // Command file for BATCH, empty or "-" reads stdin
+    std::string input;
+    // Periodic flush of SERVE, zero flushes only on demand
+    unsigned flushSeconds = 0;
+};
+
+struct BatchResult
+{
+    size_t commands = 0;
+    size_t failed = 0;
+};
+
+std::optional<Command> ParseArguments(int argc, char* argv[], std::ostream& err = std::cerr);
+bool ExecuteCommand(const Command& cmd, TaskList& tasks, 
+    std::ostream& out = std::cout, std::ostream& err = std::cerr);
+std::optional<int> ParseTaskId(char const* userInput, std::ostream& err = std::cerr);
+// LIST and SEARCH only read the list
+bool IsReadOnly(const Command& cmd) noexcept;
+
+// Splits a batch line into arguments like a shell would: whitespace
+// separates, double quotes group, \" \\ and \n escape inside quotes.
+// Returns false on an unterminated quote.
+bool SplitCommandLine(std::string_view line, std::vector<std::string>& args);
+// Inverse of SplitCommandLine, quotes only where needed
+std::string FormatCommandLine(int argc, char* argv[]);
+std::optional<Command> ParseCommandLine(std::string_view line, std::ostream& err = std::cerr);
+
+// Calls run with every line of in. Empty lines and lines starting with
+// '#' are skipped. Writes "line N: ok|failed" per command to report.
+BatchResult RunBatch(std::istream& in, std::ostream& report, 
+    const std::function<bool(std::string_view line)>& run);
+// Runs one command per line of in against tasks
+BatchResult RunBatch(std::istream& in, TaskList& tasks, std::ostream& report);
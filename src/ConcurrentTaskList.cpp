@@ -0,0 +1,256 @@
+#include "ConcurrentTaskList.h"
+
+#include <utility>
+
+namespace
+{
+    // Rebuild once this many slots are empty and they are at least half
+    constexpr size_t REBUILD_MIN_EMPTY = 1024;
+}
+
+size_t TaskSnapshot::LowerBound(int id) const noexcept
+{
+    size_t lo = 0;
+    size_t hi = m_slots;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (IdAt(mid) < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+const Task* TaskSnapshot::FindById(int id) const
+{
+    if (m_idsSorted)
+    {
+        size_t slot = LowerBound(id);
+        return slot < m_slots && IdAt(slot) == id ? TaskAt(slot) : nullptr;
+    }
+
+    const Task* found = nullptr;
+    ForEach([&](const Task& task) {
+        if (task.GetId() == id)
+            found = &task;
+    });
+    return found;
+}
+
+TaskView TaskSnapshot::Select(const TaskFilter& filter) const
+{
+    if (filter.minId > filter.maxId)
+        return {};
+
+    size_t first = 0;
+    size_t last = m_slots;
+    if (m_idsSorted)
+    {
+        first = LowerBound(filter.minId);
+        last = filter.maxId == std::numeric_limits<int>::max() ? m_slots : LowerBound(filter.maxId + 1);
+    }
+
+    std::vector<const Task*> out;
+    if (filter.status)
+        out.reserve(CountByStatus(*filter.status));
+    for (size_t slot = first; slot < last;)
+    {
+        const Leaf* leaf = LeafAt(slot);
+        size_t end = std::min(last, (slot / LEAF + 1) * LEAF);
+        for (; slot < end; ++slot)
+        {
+            size_t i = slot % LEAF;
+            if (leaf->tasks[i] && (!filter.status || leaf->statuses[i] == *filter.status)
+                && leaf->ids[i] >= filter.minId && leaf->ids[i] <= filter.maxId)
+                out.push_back(leaf->tasks[i].get());
+        }
+    }
+    return TaskView(std::move(out));
+}
+
+void TaskSnapshot::Set(size_t slot, std::shared_ptr<const Task> task)
+{
+    // Copy the path from the root down to the slot, the rest is shared
+    auto& branch = m_branches[slot / (LEAF * BRANCH)];
+    auto nextBranch = std::make_shared<Branch>(*branch);
+    auto& leaf = nextBranch->leaves[slot / LEAF % BRANCH];
+    auto nextLeaf = leaf ? std::make_shared<Leaf>(*leaf) : std::make_shared<Leaf>();
+
+    auto& entry = nextLeaf->tasks[slot % LEAF];
+    if (entry)
+    {
+        --m_size;
+        --m_counts[static_cast<size_t>(entry->GetStatus())];
+    }
+    if (task)
+    {
+        ++m_size;
+        ++m_counts[static_cast<size_t>(task->GetStatus())];
+        nextLeaf->ids[slot % LEAF] = task->GetId();
+        nextLeaf->statuses[slot % LEAF] = task->GetStatus();
+    }
+    entry = std::move(task);
+    leaf = std::move(nextLeaf);
+    branch = std::move(nextBranch);
+}
+
+size_t TaskSnapshot::Append(std::shared_ptr<const Task> task)
+{
+    size_t slot = m_slots;
+    if (slot % (LEAF * BRANCH) == 0)
+        m_branches.push_back(std::make_shared<Branch>());
+    if (slot > 0 && task->GetId() <= IdAt(slot - 1))
+        m_idsSorted = false;
+    ++m_slots;
+    Set(slot, std::move(task));
+    return slot;
+}
+
+ConcurrentTaskList::ConcurrentTaskList(const std::filesystem::path& jsonPath, TaskListOptions options)
+    : m_list(jsonPath, options)
+{
+    std::lock_guard lock(m_writeMutex);
+    Rebuild();
+}
+
+std::shared_ptr<const TaskSnapshot> ConcurrentTaskList::Snapshot() const
+{
+    return m_current.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<TaskSnapshot> ConcurrentTaskList::BeginWrite() const
+{
+    auto next = std::make_shared<TaskSnapshot>(*m_current.load(std::memory_order_relaxed));
+    ++next->m_version;
+    return next;
+}
+
+void ConcurrentTaskList::Publish(std::shared_ptr<TaskSnapshot> next)
+{
+    m_current.store(std::move(next), std::memory_order_release);
+}
+
+void ConcurrentTaskList::Rebuild()
+{
+    auto next = std::make_shared<TaskSnapshot>();
+    if (auto current = m_current.load(std::memory_order_relaxed))
+        next->m_version = current->m_version + 1;
+    m_slots.Clear();
+    m_slots.Reserve(m_list.Size());
+    m_externalChanges = m_list.ExternalChanges();
+
+    // Leaves are filled in place, nobody sees them before Publish
+    std::shared_ptr<TaskSnapshot::Branch> branch;
+    std::shared_ptr<TaskSnapshot::Leaf> leaf;
+    for (const Task& task : m_list.Select({}))
+    {
+        size_t slot = next->m_slots++;
+        if (slot % TaskSnapshot::LEAF == 0)
+        {
+            if (slot % (TaskSnapshot::LEAF * TaskSnapshot::BRANCH) == 0)
+            {
+                branch = std::make_shared<TaskSnapshot::Branch>();
+                next->m_branches.push_back(branch);
+            }
+            leaf = std::make_shared<TaskSnapshot::Leaf>();
+            branch->leaves[slot / TaskSnapshot::LEAF % TaskSnapshot::BRANCH] = leaf;
+        }
+        if (slot > 0 && task.GetId() <= next->IdAt(slot - 1))
+            next->m_idsSorted = false;
+
+        leaf->tasks[slot % TaskSnapshot::LEAF] = std::make_shared<const Task>(task);
+        leaf->ids[slot % TaskSnapshot::LEAF] = task.GetId();
+        leaf->statuses[slot % TaskSnapshot::LEAF] = task.GetStatus();
+        ++next->m_counts[static_cast<size_t>(task.GetStatus())];
+        m_slots.Insert(task.GetId(), slot);
+    }
+    next->m_size = next->m_slots;
+    Publish(std::move(next));
+}
+
+void ConcurrentTaskList::Refresh(int id)
+{
+    auto slot = m_slots.Find(id);
+    const Task* task = m_list.FindById(id);
+    if (!slot || !task || m_list.ExternalChanges() != m_externalChanges)
+    {
+        Rebuild();
+        return;
+    }
+    auto next = BeginWrite();
+    next->Set(*slot, std::make_shared<const Task>(*task));
+    Publish(std::move(next));
+}
+
+bool ConcurrentTaskList::AddTask(std::string_view desc)
+{
+    std::lock_guard lock(m_writeMutex);
+    if (!m_list.AddTask(desc))
+        return false;
+    if (m_list.ExternalChanges() != m_externalChanges)
+    {
+        Rebuild();
+        return true;
+    }
+
+    int id = m_list.NextId() - 1;
+    auto next = BeginWrite();
+    size_t slot = next->Append(std::make_shared<const Task>(*m_list.FindById(id)));
+    m_slots.Insert(id, slot);
+    Publish(std::move(next));
+    return true;
+}
+
+bool ConcurrentTaskList::UpdateTask(int id, std::string desc)
+{
+    std::lock_guard lock(m_writeMutex);
+    if (!m_list.UpdateTask(id, std::move(desc)))
+        return false;
+    Refresh(id);
+    return true;
+}
+
+bool ConcurrentTaskList::MarkTask(int id, Task::Status status)
+{
+    std::lock_guard lock(m_writeMutex);
+    if (!m_list.MarkTask(id, status))
+        return false;
+    Refresh(id);
+    return true;
+}
+
+bool ConcurrentTaskList::RemoveTask(int id)
+{
+    std::lock_guard lock(m_writeMutex);
+    if (!m_list.RemoveTask(id))
+        return false;
+    auto slot = m_slots.Find(id);
+    if (!slot || m_list.ExternalChanges() != m_externalChanges)
+    {
+        Rebuild();
+        return true;
+    }
+
+    auto next = BeginWrite();
+    next->Set(*slot, nullptr);
+    m_slots.Erase(id);
+    size_t empty = next->m_slots - next->m_size;
+    if (empty >= REBUILD_MIN_EMPTY && empty * 2 >= next->m_slots)
+    {
+        Rebuild();
+        return true;
+    }
+    Publish(std::move(next));
+    return true;
+}
+
+bool ConcurrentTaskList::Flush()
+{
+    std::lock_guard lock(m_writeMutex);
+    bool flushed = m_list.Flush();
+    if (m_list.ExternalChanges() != m_externalChanges)
+        Rebuild();
+    return flushed;
+}
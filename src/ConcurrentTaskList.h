@@ -0,0 +1,132 @@
+#pragma once
+#include "IdIndex.h"
+#include "TaskList.h"
+#include "TaskView.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Immutable state of a ConcurrentTaskList at one version. Tasks live in a
+// two-level tree of fixed-size leaves shared between versions; a mutation
+// copies only the root, one branch and one leaf. Removed tasks leave an
+// empty slot that keeps its id, so slots stay sorted when ids are.
+class TaskSnapshot
+{
+public:
+    uint64_t Version() const noexcept { return m_version; }
+    size_t Size() const noexcept { return m_size; }
+    size_t CountByStatus(Task::Status s) const noexcept { return m_counts[static_cast<size_t>(s)]; }
+
+    // nullptr if there is no such task
+    const Task* FindById(int id) const;
+    // Status and id range of the filter; keywords and time ranges are not
+    // supported here.
+    // The view stays valid as long as the snapshot is held.
+    TaskView Select(const TaskFilter& filter) const;
+
+    // Calls fn with every task in list order
+    template <typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (size_t slot = 0; slot < m_slots; slot += LEAF)
+        {
+            const Leaf* leaf = LeafAt(slot);
+            size_t count = std::min(LEAF, m_slots - slot);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (leaf->tasks[i])
+                    fn(*leaf->tasks[i]);
+            }
+        }
+    }
+
+private:
+    friend class ConcurrentTaskList;
+
+    static constexpr size_t LEAF = 256;
+    static constexpr size_t BRANCH = 256;
+
+    struct Leaf
+    {
+        std::array<std::shared_ptr<const Task>, LEAF> tasks;
+        // Copies of the task fields filters look at, so a scan stays in the leaf
+        std::array<int, LEAF> ids{};
+        std::array<Task::Status, LEAF> statuses{};
+    };
+    struct Branch
+    {
+        std::array<std::shared_ptr<const Leaf>, BRANCH> leaves;
+    };
+
+    const Leaf* LeafAt(size_t slot) const noexcept
+    {
+        return m_branches[slot / (LEAF * BRANCH)]->leaves[slot / LEAF % BRANCH].get();
+    }
+    int IdAt(size_t slot) const noexcept { return LeafAt(slot)->ids[slot % LEAF]; }
+    const Task* TaskAt(size_t slot) const noexcept { return LeafAt(slot)->tasks[slot % LEAF].get(); }
+    // First slot with an id not less than id, needs sorted ids
+    size_t LowerBound(int id) const noexcept;
+
+    // Writer side, only on a snapshot that is not published yet
+    void Set(size_t slot, std::shared_ptr<const Task> task);
+    size_t Append(std::shared_ptr<const Task> task);
+
+    std::vector<std::shared_ptr<const Branch>> m_branches;
+    size_t m_slots = 0;
+    size_t m_size = 0;
+    std::array<size_t, 3> m_counts{};
+    uint64_t m_version = 0;
+    bool m_idsSorted = true;
+};
+
+// TaskList for many reader threads and a few writers. Readers take a
+// snapshot and never block on a writer's mutation or its file I/O; writers
+// are serialized, update the wrapped TaskList (and with it the persistence)
+// and publish a new snapshot. Memory of old versions is freed when the last
+// reader lets go.
+//
+// Taking a snapshot is not lock-free: std::atomic<std::shared_ptr> uses an
+// internal lock in libstdc++ and MSVC, so a reader may wait for the pointer
+// swap of a concurrent Publish, but not for anything longer.
+class ConcurrentTaskList
+{
+public:
+    explicit ConcurrentTaskList(const std::filesystem::path& jsonPath = "task-tracker.json",
+        TaskListOptions options = {});
+
+    // Current state, consistent for as long as it is held
+    std::shared_ptr<const TaskSnapshot> Snapshot() const;
+
+    bool AddTask(std::string_view desc);
+    bool UpdateTask(int id, std::string desc);
+    bool RemoveTask(int id);
+    bool MarkTask(int id, Task::Status status);
+    bool Flush();
+
+private:
+    // Copies the current version for the next mutation
+    std::shared_ptr<TaskSnapshot> BeginWrite() const;
+    void Publish(std::shared_ptr<TaskSnapshot> next);
+    // Builds a compact snapshot from the TaskList, used at startup, once
+    // half of the slots are empty and after the list picked up changes of
+    // other processes
+    void Rebuild();
+    // Publishes the TaskList's current copy of the task
+    void Refresh(int id);
+
+    mutable std::mutex m_writeMutex;
+    TaskList m_list;
+    // Slot of every live task in the current snapshot, writer side only
+    IdIndex m_slots;
+    size_t m_externalChanges = 0;
+    // Only the writer stores; readers never take m_writeMutex to load it
+    std::atomic<std::shared_ptr<const TaskSnapshot>> m_current;
+};
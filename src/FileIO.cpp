@@ -0,0 +1,419 @@
+#include "FileIO.h"
+
+#include <atomic>
+#include <cerrno>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+    #include <fcntl.h>
+    #include <io.h>
+    #include <process.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+        #ifdef _WIN32
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+        #endif
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+
+    #ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+        m_file = file;
+        m_open = true;
+        if (size.QuadPart == 0)
+            return true;
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            Close();
+            return false;
+        }
+        m_mapping = mapping;
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            Close();
+            return false;
+        }
+        m_data = static_cast<const char*>(data);
+        m_size = static_cast<size_t>(size.QuadPart);
+        return true;
+    #else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        m_open = true;
+        if (st.st_size == 0)
+        {
+            ::close(fd);
+            return true;
+        }
+
+        void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            m_open = false;
+            return false;
+        }
+        // Loading walks the file front to back once
+        ::madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        m_data = static_cast<const char*>(data);
+        m_size = static_cast<size_t>(st.st_size);
+        return true;
+    #endif
+}
+
+void MappedFile::Close() noexcept
+{
+    #ifdef _WIN32
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        if (m_mapping)
+            CloseHandle(static_cast<HANDLE>(m_mapping));
+        if (m_file)
+            CloseHandle(static_cast<HANDLE>(m_file));
+        m_mapping = nullptr;
+        m_file = nullptr;
+    #else
+        if (m_data)
+            ::munmap(const_cast<char*>(m_data), m_size);
+    #endif
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+OutputFile::~OutputFile()
+{
+    Close();
+}
+
+OutputFile::OutputFile(OutputFile&& other) noexcept
+    : m_fd(std::exchange(other.m_fd, -1))
+{
+
+}
+
+OutputFile& OutputFile::operator=(OutputFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        m_fd = std::exchange(other.m_fd, -1);
+    }
+    return *this;
+}
+
+bool OutputFile::Open(const std::filesystem::path& path, Mode mode)
+{
+    Close();
+
+    #ifdef _WIN32
+        int flags = _O_WRONLY | _O_CREAT | _O_BINARY | _O_NOINHERIT;
+        flags |= (mode == Mode::APPEND) ? _O_APPEND : _O_TRUNC;
+        m_fd = ::_wopen(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+    #else
+        int flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+        flags |= (mode == Mode::APPEND) ? O_APPEND : O_TRUNC;
+        m_fd = ::open(path.c_str(), flags, 0644);
+    #endif
+    return m_fd >= 0;
+}
+
+bool OutputFile::Write(std::string_view data)
+{
+    if (m_fd < 0)
+        return false;
+
+    while (!data.empty())
+    {
+        #ifdef _WIN32
+            int chunk = data.size() > 0x40000000 ? 0x40000000 : static_cast<int>(data.size());
+            int n = ::_write(m_fd, data.data(), static_cast<unsigned>(chunk));
+        #else
+            ssize_t n = ::write(m_fd, data.data(), data.size());
+        #endif
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        // Nothing written for a non-empty buffer would never finish
+        if (n == 0)
+            return false;
+        data.remove_prefix(static_cast<size_t>(n));
+    }
+    return true;
+}
+
+bool OutputFile::WriteAt(std::string_view data, uint64_t offset)
+{
+    if (m_fd < 0)
+        return false;
+
+    while (!data.empty())
+    {
+        #ifdef _WIN32
+            DWORD chunk = data.size() > 0x40000000 ? 0x40000000 : static_cast<DWORD>(data.size());
+            OVERLAPPED at{};
+            at.Offset = static_cast<DWORD>(offset);
+            at.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD written = 0;
+            if (!::WriteFile(reinterpret_cast<HANDLE>(::_get_osfhandle(m_fd)), 
+                    data.data(), chunk, &written, &at))
+                return false;
+            size_t n = written;
+        #else
+            ssize_t n = ::pwrite(m_fd, data.data(), data.size(), static_cast<off_t>(offset));
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+        #endif
+        if (n == 0)
+            return false;
+        data.remove_prefix(static_cast<size_t>(n));
+        offset += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+bool OutputFile::Sync()
+{
+    if (m_fd < 0)
+        return false;
+
+    #ifdef _WIN32
+        return ::_commit(m_fd) == 0;
+    #else
+        while (::fsync(m_fd) != 0)
+        {
+            if (errno != EINTR)
+                return false;
+        }
+        return true;
+    #endif
+}
+
+bool OutputFile::Close() noexcept
+{
+    if (m_fd < 0)
+        return true;
+
+    #ifdef _WIN32
+        int rc = ::_close(m_fd);
+    #else
+        int rc = ::close(m_fd);
+    #endif
+    m_fd = -1;
+    return rc == 0;
+}
+
+std::optional<FileStamp> FileStamp::Of(const std::filesystem::path& path)
+{
+    FileStamp stamp;
+    #ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), FILE_READ_ATTRIBUTES,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return std::nullopt;
+        BY_HANDLE_FILE_INFORMATION info;
+        bool ok = GetFileInformationByHandle(file, &info);
+        CloseHandle(file);
+        if (!ok)
+            return std::nullopt;
+        stamp.device = info.dwVolumeSerialNumber;
+        stamp.inode = (uint64_t{info.nFileIndexHigh} << 32) | info.nFileIndexLow;
+        stamp.size = (uint64_t{info.nFileSizeHigh} << 32) | info.nFileSizeLow;
+        stamp.modifiedNs = static_cast<int64_t>((uint64_t{info.ftLastWriteTime.dwHighDateTime} << 32)
+            | info.ftLastWriteTime.dwLowDateTime) * 100;
+    #else
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0)
+            return std::nullopt;
+        stamp.device = static_cast<uint64_t>(st.st_dev);
+        stamp.inode = static_cast<uint64_t>(st.st_ino);
+        stamp.size = static_cast<uint64_t>(st.st_size);
+        stamp.modifiedNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+    #endif
+    return stamp;
+}
+
+FileLock::Guard::~Guard()
+{
+    if (m_lock)
+        m_lock->Release();
+}
+
+FileLock::Guard::Guard(Guard&& other) noexcept
+    : m_lock(std::exchange(other.m_lock, nullptr))
+{
+
+}
+
+FileLock::Guard& FileLock::Guard::operator=(Guard&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_lock)
+            m_lock->Release();
+        m_lock = std::exchange(other.m_lock, nullptr);
+    }
+    return *this;
+}
+
+FileLock::~FileLock()
+{
+    #ifdef _WIN32
+        if (m_file)
+            CloseHandle(static_cast<HANDLE>(m_file));
+    #else
+        if (m_fd >= 0)
+            ::close(m_fd);
+    #endif
+}
+
+bool FileLock::Open(const std::filesystem::path& path)
+{
+    #ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        if (m_file)
+            CloseHandle(static_cast<HANDLE>(m_file));
+        m_file = file;
+    #else
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+            return false;
+        if (m_fd >= 0)
+            ::close(m_fd);
+        m_fd = fd;
+    #endif
+    return true;
+}
+
+FileLock::Guard FileLock::Acquire(Mode mode)
+{
+    #ifdef _WIN32
+        if (!m_file)
+            return {};
+        OVERLAPPED overlapped = {};
+        DWORD flags = mode == Mode::EXCLUSIVE ? LOCKFILE_EXCLUSIVE_LOCK : 0;
+        if (!LockFileEx(static_cast<HANDLE>(m_file), flags, 0, 1, 0, &overlapped))
+            return {};
+    #else
+        if (m_fd < 0)
+            return {};
+        int operation = mode == Mode::EXCLUSIVE ? LOCK_EX : LOCK_SH;
+        while (::flock(m_fd, operation) != 0)
+        {
+            if (errno != EINTR)
+                return {};
+        }
+    #endif
+    return Guard(this);
+}
+
+void FileLock::Release() noexcept
+{
+    #ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        UnlockFileEx(static_cast<HANDLE>(m_file), 0, 1, 0, &overlapped);
+    #else
+        ::flock(m_fd, LOCK_UN);
+    #endif
+}
+
+std::filesystem::path FileSync::UniqueTempPath(const std::filesystem::path& target)
+{
+    static std::atomic<unsigned> counter{0};
+    #ifdef _WIN32
+        auto pid = ::_getpid();
+    #else
+        auto pid = ::getpid();
+    #endif
+    auto path = target;
+    path += ".tmp-" + std::to_string(pid) + "-" + std::to_string(counter++);
+    return path;
+}
+
+bool FileSync::Directory(const std::filesystem::path& dir)
+{
+    #ifdef _WIN32
+        (void)dir;
+        return true;
+    #else
+        int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+        int rc;
+        while ((rc = ::fsync(fd)) != 0 && errno == EINTR)
+            ;
+        ::close(fd);
+        return rc == 0;
+    #endif
+}
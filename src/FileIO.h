@@ -0,0 +1,139 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+// Read-only memory mapping of a whole file. Move-only; the mapping is
+// released on destruction or Close().
+class MappedFile
+{
+public:
+    MappedFile() noexcept = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps the file, an empty file yields an empty view
+    bool Open(const std::filesystem::path& path);
+    void Close() noexcept;
+
+    bool IsOpen() const noexcept { return m_open; }
+    std::string_view View() const noexcept { return {m_data, m_size}; }
+
+private:
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+    bool        m_open = false;
+    #ifdef _WIN32
+        void*   m_file = nullptr;
+        void*   m_mapping = nullptr;
+    #endif
+};
+
+// Unbuffered output file. Every Write() goes straight to the OS; in APPEND
+// mode each call lands at the end of the file in one piece. WriteAt()
+// leaves the file position alone, so threads may write disjoint ranges.
+class OutputFile
+{
+public:
+    enum class Mode { TRUNCATE, APPEND };
+
+    OutputFile() noexcept = default;
+    ~OutputFile();
+
+    OutputFile(OutputFile&& other) noexcept;
+    OutputFile& operator=(OutputFile&& other) noexcept;
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+    bool Open(const std::filesystem::path& path, Mode mode);
+    bool Write(std::string_view data);
+    // Positioned write (pwrite), not for APPEND mode
+    bool WriteAt(std::string_view data, uint64_t offset);
+    // Returns once everything written is on stable storage
+    bool Sync();
+    bool Close() noexcept;
+
+    bool IsOpen() const noexcept { return m_fd >= 0; }
+
+private:
+    int m_fd = -1;
+};
+
+// Durability helpers for replacing files by rename
+namespace FileSync
+{
+    // Name next to target that no other process or thread uses
+    std::filesystem::path UniqueTempPath(const std::filesystem::path& target);
+    // Makes creations and renames inside dir durable; a no-op on Windows
+    bool Directory(const std::filesystem::path& dir);
+}
+
+// Identity and last change of a file, to notice that another process
+// replaced or appended to it
+struct FileStamp
+{
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    uint64_t size = 0;
+    int64_t modifiedNs = 0;
+
+    // nullopt if the file does not exist
+    static std::optional<FileStamp> Of(const std::filesystem::path& path);
+    bool SameFile(const FileStamp& other) const noexcept
+    {
+        return device == other.device && inode == other.inode;
+    }
+    bool operator==(const FileStamp&) const = default;
+};
+
+// Advisory lock on a lock file, shared between processes. Only processes
+// that take the lock are excluded; it is not recursive.
+class FileLock
+{
+public:
+    enum class Mode { SHARED, EXCLUSIVE };
+
+    // Holds the lock until destroyed
+    class Guard
+    {
+    public:
+        Guard() noexcept = default;
+        ~Guard();
+        Guard(Guard&& other) noexcept;
+        Guard& operator=(Guard&& other) noexcept;
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        explicit operator bool() const noexcept { return m_lock != nullptr; }
+
+    private:
+        friend class FileLock;
+        explicit Guard(FileLock* lock) noexcept : m_lock(lock) {}
+        FileLock* m_lock = nullptr;
+    };
+
+    FileLock() noexcept = default;
+    ~FileLock();
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    // Creates the lock file if needed
+    bool Open(const std::filesystem::path& path);
+    // Blocks until granted; an empty guard if the lock file is not open
+    Guard Acquire(Mode mode);
+
+private:
+    void Release() noexcept;
+
+    #ifdef _WIN32
+        void* m_file = nullptr;
+    #else
+        int m_fd = -1;
+    #endif
+};
@@ -0,0 +1,102 @@
+#include "IdIndex.h"
+
+#include <algorithm>
+#include <bit>
+
+size_t IdIndex::Home(int id) const noexcept
+{
+    // Fibonacci hashing spreads the mostly consecutive ids over the table
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> 32) & m_mask;
+}
+
+void IdIndex::Clear() noexcept
+{
+    for (auto& entry : m_entries)
+        entry.slot = EMPTY;
+    m_size = 0;
+}
+
+void IdIndex::Reserve(size_t count)
+{
+    if (count * 2 > m_entries.size())
+        Rehash(std::bit_ceil(count * 2));
+}
+
+void IdIndex::Rehash(size_t capacity)
+{
+    std::vector<Entry> old;
+    old.swap(m_entries);
+    m_entries.assign(std::max<size_t>(capacity, 16), Entry{});
+    m_mask = m_entries.size() - 1;
+    m_size = 0;
+    for (const auto& entry : old)
+    {
+        if (entry.slot != EMPTY)
+            Insert(entry.id, entry.slot);
+    }
+}
+
+bool IdIndex::Insert(int id, size_t slot)
+{
+    if ((m_size + 1) * 2 > m_entries.size())
+        Rehash(m_entries.size() * 2);
+
+    for (size_t i = Home(id);; i = (i + 1) & m_mask)
+    {
+        Entry& entry = m_entries[i];
+        if (entry.slot == EMPTY)
+        {
+            entry = {id, static_cast<uint32_t>(slot)};
+            ++m_size;
+            return true;
+        }
+        if (entry.id == id)
+            return false;
+    }
+}
+
+std::optional<size_t> IdIndex::Find(int id) const noexcept
+{
+    if (m_size == 0)
+        return std::nullopt;
+    for (size_t i = Home(id);; i = (i + 1) & m_mask)
+    {
+        const Entry& entry = m_entries[i];
+        if (entry.slot == EMPTY)
+            return std::nullopt;
+        if (entry.id == id)
+            return entry.slot;
+    }
+}
+
+bool IdIndex::Erase(int id) noexcept
+{
+    if (m_size == 0)
+        return false;
+
+    size_t hole = Home(id);
+    for (;; hole = (hole + 1) & m_mask)
+    {
+        if (m_entries[hole].slot == EMPTY)
+            return false;
+        if (m_entries[hole].id == id)
+            break;
+    }
+
+    // Move back every later entry of the chain whose home position does not
+    // lie cyclically between the hole and itself
+    for (size_t i = (hole + 1) & m_mask; m_entries[i].slot != EMPTY; i = (i + 1) & m_mask)
+    {
+        size_t home = Home(m_entries[i].id);
+        bool reachable = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+        if (!reachable)
+        {
+            m_entries[hole] = m_entries[i];
+            hole = i;
+        }
+    }
+    m_entries[hole].slot = EMPTY;
+    --m_size;
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Open-addressing hash map from task id to slot. Linear probing over a
+// power-of-two table kept at most half full; erasing shifts the following
+// entries back instead of leaving tombstones, so probe chains stay short.
+class IdIndex
+{
+public:
+    void Clear() noexcept;
+    void Reserve(size_t count);
+    // Returns false and keeps the existing slot if the id is present
+    bool Insert(int id, size_t slot);
+    bool Erase(int id) noexcept;
+    std::optional<size_t> Find(int id) const noexcept;
+    size_t Size() const noexcept { return m_size; }
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    struct Entry
+    {
+        int id = 0;
+        uint32_t slot = EMPTY;
+    };
+
+    size_t Home(int id) const noexcept;
+    void Rehash(size_t capacity);
+
+    std::vector<Entry> m_entries;
+    size_t m_size = 0;
+    size_t m_mask = 0;
+};
@@ -0,0 +1,250 @@
+#include "Journal.h"
+
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+// Record layout, one line per mutation:
+//   <type> <id> <status> <timestamp-ns> <length>:<description> <fnv1a-hex>\n
+// The description is length-prefixed and may contain newlines. The checksum
+// covers everything before it and detects torn or garbage tails.
+
+namespace
+{
+    uint32_t Fnv1a(std::string_view data) noexcept
+    {
+        uint32_t hash = 2166136261u;
+        for (unsigned char c : data)
+        {
+            hash ^= c;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    bool ReadNumber(std::string_view& in, T& value, char terminator)
+    {
+        auto [ptr, ec] = std::from_chars(in.data(), in.data() + in.size(), value);
+        if (ec != std::errc{} || ptr == in.data() + in.size() || *ptr != terminator)
+            return false;
+        in.remove_prefix(static_cast<size_t>(ptr - in.data()) + 1);
+        return true;
+    }
+
+    // Parses one record from the front of in, advancing in past it
+    bool DecodeRecord(std::string_view& in, Journal::Record& record)
+    {
+        const std::string_view start = in;
+        if (in.size() < 2 || in[1] != ' ')
+            return false;
+
+        char type = in[0];
+        if (type != 'A' && type != 'U' && type != 'D' && type != 'M')
+            return false;
+        in.remove_prefix(2);
+
+        int status = 0;
+        int64_t ns = 0;
+        size_t length = 0;
+        if (!ReadNumber(in, record.id, ' ') || !ReadNumber(in, status, ' ')
+            || !ReadNumber(in, ns, ' ') || !ReadNumber(in, length, ':'))
+            return false;
+        // ' ', the checksum and '\n' follow the description; length comes
+        // from the file and must not overflow the check
+        if (status < 0 || status > 2 || in.size() < 10 || length > in.size() - 10)
+            return false;
+
+        record.description = in.substr(0, length);
+        in.remove_prefix(length);
+        if (in[0] != ' ')
+            return false;
+        in.remove_prefix(1);
+
+        const size_t covered = static_cast<size_t>(in.data() - start.data());
+        uint32_t checksum = 0;
+        auto [ptr, ec] = std::from_chars(in.data(), in.data() + 8, checksum, 16);
+        if (ec != std::errc{} || ptr != in.data() + 8 || in[8] != '\n')
+            return false;
+        if (checksum != Fnv1a(start.substr(0, covered)))
+            return false;
+        in.remove_prefix(9);
+
+        record.type = static_cast<Journal::Record::Type>(type);
+        record.status = static_cast<Task::Status>(status);
+        record.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(ns)));
+        return true;
+    }
+
+    void EncodeRecord(std::string& out, const Journal::Record& record)
+    {
+        char num[24];
+        auto append = [&](auto value, char terminator) {
+            auto [ptr, ec] = std::to_chars(num, num + sizeof(num), value);
+            out.append(num, ptr);
+            out.push_back(terminator);
+        };
+
+        out.clear();
+        out.push_back(static_cast<char>(record.type));
+        out.push_back(' ');
+        append(record.id, ' ');
+        append(static_cast<int>(record.status), ' ');
+        append(static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            record.timestamp.time_since_epoch()).count()), ' ');
+        append(record.description.size(), ':');
+        out.append(record.description);
+        out.push_back(' ');
+
+        char hex[9];
+        uint32_t checksum = Fnv1a(out);
+        for (int i = 7; i >= 0; --i)
+        {
+            hex[i] = "0123456789abcdef"[checksum & 0xF];
+            checksum >>= 4;
+        }
+        hex[8] = '\n';
+        out.append(hex, sizeof(hex));
+    }
+}
+
+bool Journal::Replay(const std::function<void(const Record&)>& apply)
+{
+    m_stamp = FileStamp::Of(m_path);
+    if (!m_stamp)
+    {
+        m_size = m_validSize = 0;
+        return true;
+    }
+
+    MappedFile file;
+    if (!file.Open(m_path))
+    {
+        std::cerr << m_path << " Could not be opened for reading\n";
+        return false;
+    }
+    m_validSize = 0;
+    ReplayTail(file.View(), file.View().size(), apply);
+    return true;
+}
+
+bool Journal::CatchUp(const std::function<void(const Record&)>& apply)
+{
+    auto stamp = FileStamp::Of(m_path);
+    if (!stamp)
+        return m_size == 0;
+    if (m_stamp ? !stamp->SameFile(*m_stamp) : m_size != 0)
+        return false;
+    if (stamp->size < m_size)
+        return false;
+    m_stamp = stamp;
+    if (stamp->size == m_size)
+        return true;
+
+    MappedFile file;
+    if (!file.Open(m_path) || file.View().size() < m_validSize)
+        return false;
+    // Our own handle appends to the same file, no need to reopen it
+    ReplayTail(file.View().substr(m_validSize), file.View().size(), apply);
+    return true;
+}
+
+void Journal::ReplayTail(std::string_view data, size_t fileSize,
+    const std::function<void(const Record&)>& apply)
+{
+    Record record;
+    while (!data.empty())
+    {
+        std::string_view rest = data;
+        if (!DecodeRecord(rest, record))
+            break;
+        apply(record);
+        data = rest;
+    }
+
+    m_size = fileSize;
+    m_validSize = m_size - data.size();
+    if (!data.empty())
+    {
+        std::cerr << "Warning: ignoring " << data.size()
+            << " bytes of incomplete journal record in " << m_path << "\n";
+        m_truncateTail = true;
+    }
+}
+
+bool Journal::Append(const Record& record)
+{
+    if (!m_file.IsOpen())
+    {
+        std::error_code ec;
+        if (m_truncateTail)
+        {
+            // Cut off the torn record so new records follow a valid one
+            std::filesystem::resize_file(m_path, m_validSize, ec);
+            if (ec)
+            {
+                std::cerr << "Error while truncating " << m_path << ": "
+                    << ec.message() << "\n";
+                return false;
+            }
+            m_truncateTail = false;
+        }
+        bool created = !FileStamp::Of(m_path);
+        if (!m_file.Open(m_path, OutputFile::Mode::APPEND))
+        {
+            std::cerr << m_path << " Could not be opened for writing\n";
+            return false;
+        }
+        // A record is only durable once the file's directory entry is
+        if (created && m_syncEvery > 0)
+            FileSync::Directory(m_path.parent_path());
+        m_stamp = FileStamp::Of(m_path);
+        m_size = m_stamp ? static_cast<size_t>(m_stamp->size) : 0;
+    }
+
+    // One write per record
+    static thread_local std::string buffer;
+    EncodeRecord(buffer, record);
+    if (!m_file.Write(buffer))
+    {
+        std::cerr << "Error while appending to " << m_path << "\n";
+        return false;
+    }
+    m_size += buffer.size();
+    m_validSize = m_size;
+    if (m_syncEvery > 0 && ++m_unsynced >= m_syncEvery)
+        return Sync();
+    return true;
+}
+
+bool Journal::Sync()
+{
+    if (m_unsynced == 0)
+        return true;
+    if (!m_file.Sync())
+    {
+        std::cerr << "Error while syncing " << m_path << "\n";
+        return false;
+    }
+    m_unsynced = 0;
+    return true;
+}
+
+bool Journal::Clear()
+{
+    m_file.Close();
+    std::error_code ec;
+    std::filesystem::remove(m_path, ec);
+    if (ec)
+    {
+        std::cerr << "Error while deleting " << m_path << ": " << ec.message() << "\n";
+        return false;
+    }
+    m_size = m_validSize = m_unsynced = 0;
+    m_truncateTail = false;
+    m_stamp.reset();
+    return true;
+}
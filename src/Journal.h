@@ -0,0 +1,65 @@
+#pragma once
+#include "FileIO.h"
+#include "Task.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+// Append-only write-ahead journal of task mutations. Records are keyed by
+// task id and carry absolute values, so replaying a journal over a snapshot
+// that already contains some of its records yields the same state.
+class Journal
+{
+public:
+    struct Record
+    {
+        enum class Type : char
+        {
+            ADD = 'A', UPDATE = 'U', DELETE = 'D', MARK = 'M'
+        };
+        Type type = Type::ADD;
+        int id = 0;
+        Task::Status status = Task::Status::TODO;
+        // createdAt for ADD, updatedAt for UPDATE and MARK
+        std::chrono::system_clock::time_point timestamp{};
+        std::string_view description;
+    };
+
+    // With syncEvery, appended records are fsynced in groups of that many
+    explicit Journal(std::filesystem::path path, size_t syncEvery = 0)
+        : m_path(std::move(path)), m_syncEvery(syncEvery) {}
+
+    // Calls apply for every complete record. A torn record at the end (crash
+    // during append) ends the replay and is cut off before the next append.
+    bool Replay(const std::function<void(const Record&)>& apply);
+    // Calls apply for the records other processes appended since this
+    // journal last read or wrote the file. False if the file was cleared or
+    // replaced meanwhile; the caller has to reload and replay from scratch.
+    bool CatchUp(const std::function<void(const Record&)>& apply);
+    bool Append(const Record& record);
+    // fsyncs the records of an incomplete group
+    bool Sync();
+    // Drops all records, e.g. after they were compacted into the snapshot
+    bool Clear();
+
+    size_t SizeBytes() const noexcept { return m_size; }
+    const std::filesystem::path& Path() const noexcept { return m_path; }
+
+private:
+    // Applies the records in data, the part of the file from m_validSize on
+    void ReplayTail(std::string_view data, size_t fileSize,
+        const std::function<void(const Record&)>& apply);
+
+    std::filesystem::path m_path;
+    OutputFile m_file;
+    // File the sizes refer to, nullopt while it does not exist
+    std::optional<FileStamp> m_stamp;
+    size_t m_size = 0;
+    size_t m_validSize = 0;
+    size_t m_syncEvery = 0;
+    size_t m_unsynced = 0;
+    bool m_truncateTail = false;
+};
@@ -0,0 +1,406 @@
+#include "JsonReader.h"
+
+#include <cstdint>
+
+namespace
+{
+    bool IsWhitespace(char c) noexcept
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    int HexValue(char c) noexcept
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    void AppendUtf8(std::string& out, uint32_t cp)
+    {
+        if (cp < 0x80)
+        {
+            out.push_back(static_cast<char>(cp));
+        }
+        else if (cp < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        else if (cp < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    constexpr int MAX_SKIP_DEPTH = 64;
+}
+
+bool JsonReader::BeginArray()
+{
+    SkipWhitespace();
+    if (m_pos < m_json.size() && m_json[m_pos] == '{')
+    {
+        // Store object: its members up to "tasks" are read, nextId kept
+        ++m_pos;
+        while (true)
+        {
+            SkipWhitespace();
+            if (m_pos >= m_json.size() || m_json[m_pos] != '"')
+                return Fail("expected \"tasks\" in task store object");
+            std::string_view key;
+            if (!ReadString(key, KEY))
+                return false;
+            SkipWhitespace();
+            if (m_pos >= m_json.size() || m_json[m_pos] != ':')
+                return Fail("expected ':' after object key");
+            ++m_pos;
+            SkipWhitespace();
+            if (key == "tasks")
+                break;
+            if (key == "nextId" ? !ReadLiteral(m_nextId) : !SkipValue())
+                return false;
+            SkipWhitespace();
+            if (m_pos >= m_json.size() || m_json[m_pos] != ',')
+                return Fail("expected ',' in task store object");
+            ++m_pos;
+        }
+    }
+    if (m_pos >= m_json.size() || m_json[m_pos] != '[')
+        return Fail("expected '[' at start of task array");
+
+    ++m_pos;
+    m_state = State::FIRST;
+    return true;
+}
+
+bool JsonReader::NextTask(TaskFields& fields)
+{
+    if (m_state == State::START)
+        return Fail("BeginArray() was not called");
+    if (m_state == State::END || Failed())
+        return false;
+
+    SkipWhitespace();
+    if (m_pos >= m_json.size())
+        return Fail("unexpected end of input, missing ']'");
+
+    char c = m_json[m_pos];
+    if (c == ']')
+    {
+        ++m_pos;
+        m_state = State::END;
+        return false;
+    }
+
+    if (m_state == State::NEXT)
+    {
+        if (c != ',')
+            return Fail("expected ',' or ']' after object");
+        ++m_pos;
+        SkipWhitespace();
+    }
+
+    if (!ReadObject(fields))
+        return false;
+
+    m_state = State::NEXT;
+    return true;
+}
+
+bool JsonReader::ReadTask(TaskFields& fields)
+{
+    SkipWhitespace();
+    return ReadObject(fields);
+}
+
+bool JsonReader::ReadObject(TaskFields& fields)
+{
+    if (m_pos >= m_json.size() || m_json[m_pos] != '{')
+        return Fail("expected '{'");
+    const size_t start = m_pos++;
+
+    fields = TaskFields{};
+    SkipWhitespace();
+    if (m_pos < m_json.size() && m_json[m_pos] == '}')
+    {
+        ++m_pos;
+        fields.object = m_json.substr(start, m_pos - start);
+        return true;
+    }
+
+    while (true)
+    {
+        // key
+        SkipWhitespace();
+        if (m_pos >= m_json.size() || m_json[m_pos] != '"')
+            return Fail("expected object key");
+        std::string_view key;
+        if (!ReadString(key, KEY))
+            return false;
+
+        SkipWhitespace();
+        if (m_pos >= m_json.size() || m_json[m_pos] != ':')
+            return Fail("expected ':' after object key");
+        ++m_pos;
+        SkipWhitespace();
+
+        // value
+        std::string_view* target = nullptr;
+        Field slot = KEY;
+        unsigned flag = 0;
+        if (key == "id")
+        {
+            target = &fields.id; slot = ID; flag = TaskFields::HAS_ID;
+        }
+        else if (key == "description")
+        {
+            target = &fields.description; slot = DESCRIPTION; flag = TaskFields::HAS_DESCRIPTION;
+        }
+        else if (key == "status")
+        {
+            target = &fields.status; slot = STATUS; flag = TaskFields::HAS_STATUS;
+        }
+        else if (key == "createdAt")
+        {
+            target = &fields.createdAt; slot = CREATED_AT; flag = TaskFields::HAS_CREATED_AT;
+        }
+        else if (key == "updatedAt")
+        {
+            target = &fields.updatedAt; slot = UPDATED_AT; flag = TaskFields::HAS_UPDATED_AT;
+        }
+
+        if (m_pos >= m_json.size())
+            return Fail("unexpected end of input, missing value");
+
+        if (!target)
+        {
+            if (!SkipValue())
+                return false;
+        }
+        else if (m_json[m_pos] == '"')
+        {
+            if (!ReadString(*target, slot))
+                return false;
+            fields.present |= flag;
+        }
+        else
+        {
+            if (!ReadLiteral(*target))
+                return false;
+            fields.present |= flag;
+        }
+
+        SkipWhitespace();
+        if (m_pos >= m_json.size())
+            return Fail("unexpected end of input, missing '}'");
+        if (m_json[m_pos] == ',')
+        {
+            ++m_pos;
+            continue;
+        }
+        if (m_json[m_pos] == '}')
+        {
+            ++m_pos;
+            fields.object = m_json.substr(start, m_pos - start);
+            return true;
+        }
+        return Fail("expected ',' or '}' in object");
+    }
+}
+
+bool JsonReader::ReadString(std::string_view& out, Field slot)
+{
+    // m_json[m_pos] is the opening quote
+    const size_t start = ++m_pos;
+    const char* data = m_json.data();
+    const size_t size = m_json.size();
+
+    // Fast path: no escapes, hand out a view into the input
+    size_t i = start;
+    while (i < size && data[i] != '"' && data[i] != '\\')
+        ++i;
+    if (i >= size)
+        return Fail("unterminated string");
+    if (data[i] == '"')
+    {
+        out = m_json.substr(start, i - start);
+        m_pos = i + 1;
+        return true;
+    }
+
+    // Slow path: decode into the scratch buffer of this field
+    std::string& buf = m_scratch[slot];
+    buf.assign(data + start, i - start);
+    while (i < size)
+    {
+        char c = data[i];
+        if (c == '"')
+        {
+            out = buf;
+            m_pos = i + 1;
+            return true;
+        }
+        if (c != '\\')
+        {
+            // copy the run up to the next quote or escape in one go
+            size_t run = i;
+            while (run < size && data[run] != '"' && data[run] != '\\')
+                ++run;
+            buf.append(data + i, run - i);
+            i = run;
+            continue;
+        }
+
+        if (++i >= size)
+            break;
+        switch (data[i])
+        {
+            case '"': buf.push_back('"'); break;
+            case '\\': buf.push_back('\\'); break;
+            case '/': buf.push_back('/'); break;
+            case 'b': buf.push_back('\b'); break;
+            case 'f': buf.push_back('\f'); break;
+            case 'n': buf.push_back('\n'); break;
+            case 'r': buf.push_back('\r'); break;
+            case 't': buf.push_back('\t'); break;
+            case 'u':
+            {
+                auto readHex4 = [&](size_t at, uint32_t& value) {
+                    if (at + 4 > size)
+                        return false;
+                    value = 0;
+                    for (size_t k = 0; k < 4; ++k)
+                    {
+                        int h = HexValue(data[at + k]);
+                        if (h < 0)
+                            return false;
+                        value = (value << 4) | static_cast<uint32_t>(h);
+                    }
+                    return true;
+                };
+
+                uint32_t cp = 0;
+                if (!readHex4(i + 1, cp))
+                    return Fail("invalid \\u escape");
+                i += 4;
+
+                if (cp >= 0xD800 && cp <= 0xDBFF)
+                {
+                    // high surrogate, expect a low surrogate to follow
+                    uint32_t low = 0;
+                    if (i + 2 < size && data[i + 1] == '\\' && data[i + 2] == 'u'
+                        && readHex4(i + 3, low) && low >= 0xDC00 && low <= 0xDFFF)
+                    {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                    else
+                    {
+                        cp = 0xFFFD;
+                    }
+                }
+                else if (cp >= 0xDC00 && cp <= 0xDFFF)
+                {
+                    cp = 0xFFFD;
+                }
+                AppendUtf8(buf, cp);
+                break;
+            }
+            default:
+                return Fail("invalid escape sequence");
+        }
+        ++i;
+    }
+
+    return Fail("unterminated string");
+}
+
+bool JsonReader::ReadLiteral(std::string_view& out)
+{
+    // numbers, true, false, null
+    const size_t start = m_pos;
+    while (m_pos < m_json.size())
+    {
+        char c = m_json[m_pos];
+        if (c == ',' || c == '}' || c == ']' || IsWhitespace(c))
+            break;
+        if (c == '"' || c == '{' || c == '[' || c == ':')
+            return Fail("unexpected character in value");
+        ++m_pos;
+    }
+    if (m_pos == start)
+        return Fail("missing value");
+
+    out = m_json.substr(start, m_pos - start);
+    return true;
+}
+
+bool JsonReader::SkipValue()
+{
+    // Skips one value of any kind, including nested objects and arrays
+    std::string_view ignored;
+    int depth = 0;
+    do
+    {
+        SkipWhitespace();
+        if (m_pos >= m_json.size())
+            return Fail("unexpected end of input");
+
+        char c = m_json[m_pos];
+        if (c == '"')
+        {
+            if (!ReadString(ignored, KEY))
+                return false;
+        }
+        else if (c == '{' || c == '[')
+        {
+            if (++depth > MAX_SKIP_DEPTH)
+                return Fail("nesting too deep");
+            ++m_pos;
+        }
+        else if (c == '}' || c == ']')
+        {
+            if (depth == 0)
+                return Fail("unexpected closing bracket");
+            --depth;
+            ++m_pos;
+        }
+        else if (c == ',' || c == ':')
+        {
+            if (depth == 0)
+                return Fail("missing value");
+            ++m_pos;
+        }
+        else if (!ReadLiteral(ignored))
+        {
+            return false;
+        }
+    } while (depth > 0);
+
+    return true;
+}
+
+bool JsonReader::Fail(std::string_view message)
+{
+    if (m_error.empty())
+        m_error = message;
+    m_state = State::END;
+    return false;
+}
+
+void JsonReader::SkipWhitespace() noexcept
+{
+    while (m_pos < m_json.size() && IsWhitespace(m_json[m_pos]))
+        ++m_pos;
+}
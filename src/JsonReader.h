@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Single-pass pull reader for the task store format: a JSON array of flat
+// objects, or an object {"nextId": N, "tasks": [...]} holding that array
+// for a store whose next id is above its tasks' ids. Every byte of the input is visited once; values are handed out
+// as views into the input, or into a reused scratch buffer when a string
+// contains escape sequences.
+class JsonReader
+{
+public:
+    // Raw field values of one task object. Views stay valid until the
+    // next call to NextTask().
+    struct TaskFields
+    {
+        std::string_view id;
+        std::string_view description;
+        std::string_view status;
+        std::string_view createdAt;
+        std::string_view updatedAt;
+        // The whole object as it appears in the input
+        std::string_view object;
+
+        enum : unsigned
+        {
+            HAS_ID = 1u << 0,
+            HAS_DESCRIPTION = 1u << 1,
+            HAS_STATUS = 1u << 2,
+            HAS_CREATED_AT = 1u << 3,
+            HAS_UPDATED_AT = 1u << 4,
+            HAS_ALL = (1u << 5) - 1
+        };
+        unsigned present = 0;
+    };
+
+    explicit JsonReader(std::string_view json) noexcept : m_json(json) {}
+
+    // Consumes the opening '[' of the task array, and the store object's
+    // members in front of it
+    bool BeginArray();
+    // The store object's nextId value as written, empty without one
+    std::string_view NextId() const noexcept { return m_nextId; }
+    // Reads the next object into fields. Returns false at the closing ']'
+    // or on error; check Failed() to tell both apart.
+    bool NextTask(TaskFields& fields);
+    // Reads a single object, e.g. one that NextTask handed out before
+    bool ReadTask(TaskFields& fields);
+    // Continues the task array at the object starting at offset instead of
+    // calling BeginArray, to read it in chunks
+    void Seek(size_t offset) noexcept
+    {
+        m_pos = offset;
+        m_state = State::FIRST;
+    }
+
+    bool Failed() const noexcept { return !m_error.empty(); }
+    std::string_view Error() const noexcept { return m_error; }
+    size_t Offset() const noexcept { return m_pos; }
+    // True if value points into the input rather than a scratch buffer
+    bool IsInput(std::string_view value) const noexcept
+    {
+        return value.data() >= m_json.data() 
+            && value.data() + value.size() <= m_json.data() + m_json.size();
+    }
+
+private:
+    enum class State { START, FIRST, NEXT, END };
+    enum Field { ID, DESCRIPTION, STATUS, CREATED_AT, UPDATED_AT, KEY, FIELD_COUNT };
+
+    bool ReadObject(TaskFields& fields);
+    bool ReadString(std::string_view& out, Field slot);
+    bool ReadLiteral(std::string_view& out);
+    bool SkipValue();
+    bool Fail(std::string_view message);
+    void SkipWhitespace() noexcept;
+
+    std::string_view m_json;
+    size_t m_pos = 0;
+    State m_state = State::START;
+    std::string_view m_error;
+    std::string_view m_nextId;
+    std::string m_scratch[FIELD_COUNT];
+};
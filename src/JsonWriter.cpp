@@ -0,0 +1,142 @@
+#include "JsonWriter.h"
+#include "TimeCodec.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace
+{
+    constexpr int MAX_INDENT = 64;
+    constexpr auto SPACES = [] {
+        struct Spaces { char value[MAX_INDENT + 4]; } spaces{};
+        for (char& c : spaces.value)
+            c = ' ';
+        return spaces;
+    }();
+
+    // Escape class per byte: 0 = copy, otherwise the character after '\'
+    // ('u' for \u00XX)
+    constexpr auto ESCAPES = [] {
+        struct Table { char value[256]; } table{};
+        for (int c = 0; c < 0x20; ++c)
+            table.value[c] = 'u';
+        table.value['\b'] = 'b';
+        table.value['\f'] = 'f';
+        table.value['\n'] = 'n';
+        table.value['\r'] = 'r';
+        table.value['\t'] = 't';
+        table.value['"'] = '"';
+        table.value['\\'] = '\\';
+        return table;
+    }();
+
+    char* Put(char* out, std::string_view text) noexcept
+    {
+        std::memcpy(out, text.data(), text.size());
+        return out + text.size();
+    }
+
+    char* PutTimestamp(char* out, std::chrono::system_clock::time_point tp) noexcept
+    {
+        TimeCodec::Format(tp, out);
+        return out + TimeCodec::TIMESTAMP_SIZE;
+    }
+}
+
+char* JsonWriter::Reserve(size_t n)
+{
+    if (m_size + n > m_capacity)
+    {
+        size_t capacity = std::max(m_capacity * 2, m_size + n);
+        capacity = std::max<size_t>(capacity, 4096);
+        auto data = std::make_unique<char[]>(capacity);
+        if (m_size)
+            std::memcpy(data.get(), m_data.get(), m_size);
+        m_data = std::move(data);
+        m_capacity = capacity;
+    }
+    return m_data.get() + m_size;
+}
+
+void JsonWriter::Append(std::string_view text)
+{
+    char* out = Reserve(text.size());
+    std::memcpy(out, text.data(), text.size());
+    m_size += text.size();
+}
+
+void JsonWriter::AppendEscaped(std::string_view text)
+{
+    // Worst case every byte becomes \u00XX
+    char* const begin = Reserve(text.size() * 6);
+    char* out = begin;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end)
+    {
+        // copy runs that need no escaping in one go
+        const char* run = p;
+        while (run < end && !ESCAPES.value[static_cast<unsigned char>(*run)])
+            ++run;
+        std::memcpy(out, p, static_cast<size_t>(run - p));
+        out += run - p;
+        if (run == end)
+            break;
+
+        char escape = ESCAPES.value[static_cast<unsigned char>(*run)];
+        *out++ = '\\';
+        *out++ = escape;
+        if (escape == 'u')
+        {
+            unsigned char c = static_cast<unsigned char>(*run);
+            *out++ = '0';
+            *out++ = '0';
+            *out++ = "0123456789abcdef"[c >> 4];
+            *out++ = "0123456789abcdef"[c & 0xF];
+        }
+        p = run + 1;
+    }
+    m_size += static_cast<size_t>(out - begin);
+}
+
+void JsonWriter::AppendTask(const Task& task, int indent)
+{
+    const std::string_view ind{SPACES.value, static_cast<size_t>(std::clamp(indent, 0, MAX_INDENT))};
+    const std::string_view inner{SPACES.value, ind.size() + 4};
+
+    // id, status and timestamps; the description is appended separately
+    char* const begin = Reserve(8 * inner.size() + 160);
+    char* out = begin;
+    out = Put(out, ind);
+    out = Put(out, "{\n");
+    out = Put(out, inner);
+    out = Put(out, "\"id\": ");
+    out = std::to_chars(out, out + 16, task.GetId()).ptr;
+    out = Put(out, ",\n");
+    out = Put(out, inner);
+    out = Put(out, "\"description\": \"");
+    m_size += static_cast<size_t>(out - begin);
+
+    AppendEscaped(task.GetDescription());
+
+    auto updatedAt = task.GetUpdatedAt();
+    char* const rest = Reserve(4 * inner.size() + ind.size() + 128);
+    out = rest;
+    out = Put(out, "\",\n");
+    out = Put(out, inner);
+    out = Put(out, "\"status\": \"");
+    out = Put(out, Task::toString(task.GetStatus()));
+    out = Put(out, "\",\n");
+    out = Put(out, inner);
+    out = Put(out, "\"createdAt\": \"");
+    out = PutTimestamp(out, task.GetCreatedAt());
+    out = Put(out, "\",\n");
+    out = Put(out, inner);
+    out = Put(out, "\"updatedAt\": \"");
+    out = updatedAt ? PutTimestamp(out, *updatedAt) : Put(out, "null");
+    out = Put(out, "\"\n");
+    out = Put(out, ind);
+    out = Put(out, "}");
+    m_size += static_cast<size_t>(out - rest);
+}
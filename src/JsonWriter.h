@@ -0,0 +1,34 @@
+#pragma once
+#include "Task.h"
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+// Growable output buffer for the task store format. Tasks are serialized
+// with to_chars and TimeCodec straight into the buffer, strings are
+// escaped, and the caller writes the whole buffer out in one call.
+class JsonWriter
+{
+public:
+    JsonWriter() = default;
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    // One task object, starting and ending at the given indentation
+    void AppendTask(const Task& task, int indent = 4);
+    // Appends text as a JSON string body, without the surrounding quotes
+    void AppendEscaped(std::string_view text);
+    void Append(std::string_view text);
+
+    std::string_view View() const noexcept { return {m_data.get(), m_size}; }
+    size_t Size() const noexcept { return m_size; }
+    // Empties the buffer but keeps its capacity
+    void Clear() noexcept { m_size = 0; }
+
+private:
+    char* Reserve(size_t n);
+
+    std::unique_ptr<char[]> m_data;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+};
@@ -0,0 +1,252 @@
+#include "KeywordIndex.h"
+#include "SubstringScan.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    bool IsTermChar(unsigned char c) noexcept
+    {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z')
+            || (c >= 'A' && c <= 'Z') || c >= 0x80;
+    }
+
+    char Lower(unsigned char c) noexcept
+    {
+        return static_cast<char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+    }
+
+    // Unique terms of text, for Add and Remove
+    const std::vector<std::string>& UniqueTerms(std::string_view text)
+    {
+        thread_local std::vector<std::string> terms;
+        terms.clear();
+        KeywordIndex::Tokenize(text, [](std::string_view term) { terms.emplace_back(term); });
+        std::sort(terms.begin(), terms.end());
+        terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+        return terms;
+    }
+
+    void Intersect(std::vector<int>& acc, const std::vector<int>& ids)
+    {
+        // Merge lists of similar size, binary search into much longer ones
+        if (ids.size() < acc.size() * 16)
+        {
+            auto end = std::set_intersection(acc.begin(), acc.end(),
+                ids.begin(), ids.end(), acc.begin());
+            acc.erase(end, acc.end());
+            return;
+        }
+
+        auto out = acc.begin();
+        auto it = ids.begin();
+        for (int id : acc)
+        {
+            it = std::lower_bound(it, ids.end(), id);
+            if (it == ids.end())
+                break;
+            if (*it == id)
+                *out++ = id;
+        }
+        acc.erase(out, acc.end());
+    }
+}
+
+void KeywordIndex::Tokenize(std::string_view text, const std::function<void(std::string_view)>& fn)
+{
+    thread_local std::string term;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        while (i < text.size() && !IsTermChar(static_cast<unsigned char>(text[i])))
+            ++i;
+        term.clear();
+        while (i < text.size() && IsTermChar(static_cast<unsigned char>(text[i])))
+            term.push_back(Lower(static_cast<unsigned char>(text[i++])));
+        if (!term.empty())
+            fn(term);
+    }
+}
+
+void KeywordIndex::Clear() noexcept
+{
+    m_postings.clear();
+    m_sortedTerms.clear();
+    m_sortedValid = false;
+}
+
+void KeywordIndex::Add(int id, std::string_view text)
+{
+    for (const auto& term : UniqueTerms(text))
+    {
+        auto it = m_postings.find(term);
+        if (it == m_postings.end())
+        {
+            it = m_postings.emplace(term, std::vector<int>{}).first;
+            m_sortedValid = false;
+        }
+
+        // New tasks get the largest id, so this is almost always an append
+        auto& ids = it->second;
+        if (ids.empty() || ids.back() < id)
+            ids.push_back(id);
+        else
+        {
+            auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+            if (*pos != id)
+                ids.insert(pos, id);
+        }
+    }
+}
+
+void KeywordIndex::Remove(int id, std::string_view text)
+{
+    for (const auto& term : UniqueTerms(text))
+    {
+        auto it = m_postings.find(term);
+        if (it == m_postings.end())
+            continue;
+
+        auto& ids = it->second;
+        auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+        if (pos != ids.end() && *pos == id)
+            ids.erase(pos);
+        if (ids.empty())
+        {
+            m_postings.erase(it);
+            m_sortedValid = false;
+        }
+    }
+}
+
+const std::vector<int>* KeywordIndex::Lookup(std::string_view term, bool prefix,
+    std::vector<int>& scratch) const
+{
+    static const std::vector<int> none;
+    if (!prefix)
+    {
+        auto it = m_postings.find(term);
+        return it == m_postings.end() ? &none : &it->second;
+    }
+
+    {
+        std::lock_guard lock(m_sortMutex);
+        if (!m_sortedValid)
+        {
+            m_sortedTerms.clear();
+            m_sortedTerms.reserve(m_postings.size());
+            for (const auto& entry : m_postings)
+                m_sortedTerms.push_back(entry.first);
+            std::sort(m_sortedTerms.begin(), m_sortedTerms.end());
+            m_sortedValid = true;
+        }
+    }
+
+    scratch.clear();
+    for (auto it = std::lower_bound(m_sortedTerms.begin(), m_sortedTerms.end(), term);
+        it != m_sortedTerms.end() && it->substr(0, term.size()) == term; ++it)
+    {
+        const auto& ids = m_postings.find(*it)->second;
+        scratch.insert(scratch.end(), ids.begin(), ids.end());
+    }
+    std::sort(scratch.begin(), scratch.end());
+    scratch.erase(std::unique(scratch.begin(), scratch.end()), scratch.end());
+    return &scratch;
+}
+
+KeywordIndex::Matcher::Matcher(std::string_view query)
+{
+    m_alternatives.emplace_back();
+    size_t i = 0;
+    while (i < query.size())
+    {
+        while (i < query.size() && (query[i] == ' ' || query[i] == '\t'))
+            ++i;
+        size_t start = i;
+        while (i < query.size() && query[i] != ' ' && query[i] != '\t')
+            ++i;
+        std::string_view word = query.substr(start, i - start);
+        if (word.empty())
+            break;
+        if (word == "OR")
+        {
+            m_alternatives.emplace_back();
+            continue;
+        }
+        if (word == "AND")
+            continue;
+
+        if (word.front() == '*')
+        {
+            std::string_view fragment = word.substr(1);
+            if (!fragment.empty() && fragment.back() == '*')
+                fragment.remove_suffix(1);
+            if (!fragment.empty())
+                m_alternatives.back().push_back({std::string(fragment), false, true});
+            continue;
+        }
+
+        bool prefix = word.back() == '*';
+        if (prefix)
+            word.remove_suffix(1);
+
+        // "foo-bar" is two terms, both required; only the last one is a prefix
+        auto& conditions = m_alternatives.back();
+        size_t first = conditions.size();
+        Tokenize(word, [&](std::string_view term) { conditions.push_back({std::string(term)}); });
+        if (prefix && conditions.size() > first)
+            conditions.back().prefix = true;
+    }
+}
+
+bool KeywordIndex::Matcher::Matches(std::string_view text) const
+{
+    thread_local std::vector<std::string> terms;
+    terms.clear();
+    Tokenize(text, [](std::string_view term) { terms.emplace_back(term); });
+
+    auto holds = [&](const Condition& condition) {
+        if (condition.fragment)
+            return SubstringScan::Find(text, condition.term, true) != std::string_view::npos;
+        return std::any_of(terms.begin(), terms.end(), [&](const std::string& term) {
+            return condition.prefix ? term.starts_with(condition.term) : term == condition.term;
+        });
+    };
+    // An alternative without conditions matches nothing, as in Query
+    return std::any_of(m_alternatives.begin(), m_alternatives.end(), [&](const auto& conditions) {
+        return !conditions.empty() && std::all_of(conditions.begin(), conditions.end(), holds);
+    });
+}
+
+std::vector<int> KeywordIndex::Query(std::string_view query, const Scanner& scan) const
+{
+    std::vector<int> result;
+    std::vector<int> group;
+    std::vector<int> scratch;
+    for (const auto& conditions : Matcher(query).m_alternatives)
+    {
+        if (conditions.empty())
+            continue;
+        for (size_t c = 0; c < conditions.size(); ++c)
+        {
+            const auto& condition = conditions[c];
+            std::vector<int> scanned;
+            if (condition.fragment && scan)
+                scanned = scan(condition.term);
+            const std::vector<int>& ids = condition.fragment ? scanned
+                : *Lookup(condition.term, condition.prefix, scratch);
+            if (c == 0)
+                group = ids;
+            else
+                Intersect(group, ids);
+        }
+
+        std::vector<int> merged;
+        merged.reserve(result.size() + group.size());
+        std::set_union(result.begin(), result.end(), group.begin(), group.end(),
+            std::back_inserter(merged));
+        result.swap(merged);
+    }
+    return result;
+}
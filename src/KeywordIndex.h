@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Inverted index from lowercase description terms to the sorted ids of the
+// tasks that contain them. Terms are runs of ASCII letters and digits;
+// bytes outside ASCII count as letters so UTF-8 words stay in one piece.
+class KeywordIndex
+{
+public:
+    void Add(int id, std::string_view text);
+    // text must be the description the id was added with
+    void Remove(int id, std::string_view text);
+    void Clear() noexcept;
+
+    // Sorted ids of the tasks containing a fragment anywhere in the text
+    using Scanner = std::function<std::vector<int>(std::string_view fragment)>;
+
+    // Whitespace separated terms are ANDed, "OR" between terms starts an
+    // alternative and a trailing '*' matches every term with that prefix,
+    // e.g. "fix parser OR deploy*". A leading '*' ("*arse*") asks for a
+    // substring the index cannot answer; it is passed on to scan and
+    // matches nothing without one. Returns sorted ids.
+    std::vector<int> Query(std::string_view query, const Scanner& scan = {}) const;
+
+    size_t TermCount() const noexcept { return m_postings.size(); }
+
+    // A query tested against one text at a time, for one-off searches where
+    // building the index would cost more than the query saves. Matches what
+    // Query on an index of the same texts returns; fragments are searched
+    // case-insensitively in the text.
+    class Matcher
+    {
+    public:
+        explicit Matcher(std::string_view query);
+        bool Matches(std::string_view text) const;
+
+    private:
+        friend class KeywordIndex;
+        struct Condition
+        {
+            std::string term;
+            bool prefix = false;
+            // A "*fragment*" word, term holds the fragment
+            bool fragment = false;
+        };
+        // Alternatives separated by OR, each a list of ANDed conditions
+        std::vector<std::vector<Condition>> m_alternatives;
+    };
+
+    // Calls fn with every lowercase term of text, duplicates included
+    static void Tokenize(std::string_view text, const std::function<void(std::string_view)>& fn);
+
+private:
+    // Ids of one query term, prefix terms are merged into scratch
+    const std::vector<int>* Lookup(std::string_view term, bool prefix,
+        std::vector<int>& scratch) const;
+
+    struct TermHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view term) const noexcept
+        {
+            return std::hash<std::string_view>{}(term);
+        }
+    };
+
+    std::unordered_map<std::string, std::vector<int>, TermHash, std::equal_to<>> m_postings;
+    // Sorted view of the terms for prefix lookups, rebuilt after the set
+    // of terms changed. The mutex lets concurrent queries share the rebuild.
+    mutable std::mutex m_sortMutex;
+    mutable std::vector<std::string_view> m_sortedTerms;
+    mutable bool m_sortedValid = false;
+};
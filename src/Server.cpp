@@ -0,0 +1,507 @@
+#include "Server.h"
+#include "Command.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+#ifndef _WIN32
+    #include <cerrno>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    // Requests are single command lines, anything longer is garbage
+    constexpr size_t MAX_REQUEST = 64 * 1024;
+
+#ifndef _WIN32
+    bool FillAddress(const std::filesystem::path& path, sockaddr_un& addr)
+    {
+        const std::string& native = path.native();
+        if (native.empty() || native.size() >= sizeof(addr.sun_path))
+            return false;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, native.c_str(), native.size() + 1);
+        return true;
+    }
+
+    void SetCloseOnExec(int fd)
+    {
+        fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+    }
+
+    // Whether the process on the other end of a connection runs as our user
+    bool PeerIsUser(int fd)
+    {
+        #ifdef __linux__
+            ucred cred;
+            socklen_t length = sizeof(cred);
+            return getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &length) == 0
+                && cred.uid == getuid();
+        #else
+            uid_t uid;
+            gid_t gid;
+            return getpeereid(fd, &uid, &gid) == 0 && uid == getuid();
+        #endif
+    }
+
+    // Only connects to a socket file owned by our user with a server running
+    // as our user behind it; anyone else could read and forge task commands
+    int ConnectTo(const std::filesystem::path& path)
+    {
+        sockaddr_un addr;
+        struct stat info;
+        if (!FillAddress(path, addr) || lstat(path.c_str(), &info) != 0
+            || !S_ISSOCK(info.st_mode) || info.st_uid != getuid())
+            return -1;
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return -1;
+        SetCloseOnExec(fd);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+            || !PeerIsUser(fd))
+        {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    // The socket's directory must exist and be one other users cannot
+    // replace entries in: ours or root's, and not writable by others unless
+    // sticky like /tmp. A missing directory is created private to our user.
+    bool PrepareDirectory(const std::filesystem::path& dir)
+    {
+        if (dir.empty())
+            return true;
+        if (mkdir(dir.c_str(), S_IRWXU) != 0 && errno != EEXIST)
+            return false;
+        struct stat info;
+        if (lstat(dir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode))
+            return false;
+        if (info.st_uid != getuid() && info.st_uid != 0)
+            return false;
+        return (info.st_mode & (S_IWGRP | S_IWOTH)) == 0 || (info.st_mode & S_ISVTX) != 0;
+    }
+
+    bool SendAll(int fd, std::string_view data)
+    {
+        #ifdef MSG_NOSIGNAL
+            constexpr int flags = MSG_NOSIGNAL;
+        #else
+            constexpr int flags = 0;
+        #endif
+        while (!data.empty())
+        {
+            ssize_t n = send(fd, data.data(), data.size(), flags);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return false;
+            data.remove_prefix(static_cast<size_t>(n));
+        }
+        return true;
+    }
+
+    // Appends what arrives to buffer, false on EOF or error
+    bool Receive(int fd, std::string& buffer)
+    {
+        char chunk[4096];
+        while (true)
+        {
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return false;
+            buffer.append(chunk, static_cast<size_t>(n));
+            return true;
+        }
+    }
+#endif
+}
+
+std::filesystem::path TaskProtocol::DefaultSocketPath()
+{
+    if (const char* path = std::getenv("TASK_CLI_SOCKET"); path && *path)
+        return path;
+
+    #ifdef _WIN32
+        std::error_code ec;
+        return std::filesystem::temp_directory_path(ec) / "task-tracker.sock";
+    #else
+        // The runtime directory belongs to the user and is private already
+        if (const char* dir = std::getenv("XDG_RUNTIME_DIR"); dir && *dir == '/')
+            return std::filesystem::path(dir) / "task-tracker.sock";
+        std::error_code ec;
+        auto dir = std::filesystem::temp_directory_path(ec) / ("task-tracker-" + std::to_string(getuid()));
+        return dir / "task-tracker.sock";
+    #endif
+}
+
+TaskServer::TaskServer(TaskList& tasks, Options options)
+    : m_tasks(tasks), m_options(std::move(options))
+{
+    #ifndef _WIN32
+        if (pipe(m_wakeFds) == 0)
+        {
+            SetCloseOnExec(m_wakeFds[0]);
+            SetCloseOnExec(m_wakeFds[1]);
+        }
+        else
+        {
+            m_wakeFds[0] = m_wakeFds[1] = -1;
+        }
+    #endif
+}
+
+TaskServer::~TaskServer()
+{
+    #ifndef _WIN32
+        for (int fd : m_wakeFds)
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+    #endif
+}
+
+void TaskServer::SetReady(bool listening)
+{
+    m_ready = listening ? 1 : 2;
+    m_ready.notify_all();
+}
+
+bool TaskServer::WaitReady()
+{
+    m_ready.wait(0);
+    return m_ready == 1;
+}
+
+void TaskServer::Stop() noexcept
+{
+    m_stopping = true;
+    #ifndef _WIN32
+        if (m_wakeFds[1] >= 0)
+        {
+            char wake = 0;
+            [[maybe_unused]] auto n = write(m_wakeFds[1], &wake, 1);
+        }
+    #endif
+}
+
+bool TaskServer::Flush(bool force)
+{
+    if (!m_dirty.exchange(false) && !force)
+        return true;
+    std::unique_lock lock(m_tasksMutex);
+    if (m_tasks.Flush())
+        return true;
+    m_dirty = true;
+    return false;
+}
+
+bool TaskServer::SyncJournal()
+{
+    if (!m_unsynced.exchange(false))
+        return true;
+    std::unique_lock lock(m_tasksMutex);
+    if (m_tasks.SyncJournal())
+        return true;
+    m_unsynced = true;
+    return false;
+}
+
+std::string TaskServer::Handle(std::string_view line)
+{
+    std::ostringstream out;
+    bool ok = false;
+    // Parse errors go to the client like those of the command itself
+    auto command = ParseCommandLine(line, out);
+    if (!command)
+    {
+        ok = false;
+    }
+    else if (command->type == Command::Type::FLUSH)
+    {
+        ok = Flush(true);
+        if (!ok)
+            out << "Error: Could not write the store" << std::endl;
+    }
+    else if (IsReadOnly(*command))
+    {
+        std::shared_lock lock(m_tasksMutex);
+        ok = ExecuteCommand(*command, m_tasks, out, out);
+    }
+    else
+    {
+        std::unique_lock lock(m_tasksMutex);
+        ok = ExecuteCommand(*command, m_tasks, out, out);
+        if (ok)
+            m_dirty = m_unsynced = true;
+    }
+
+    std::string output = std::move(out).str();
+    std::string response = ok ? "OK " : "ERR ";
+    response += std::to_string(output.size());
+    response += '\n';
+    response += output;
+    return response;
+}
+
+#ifdef _WIN32
+
+bool TaskServer::Run()
+{
+    std::cerr << "Error: serve is not supported on this platform" << std::endl;
+    SetReady(false);
+    return false;
+}
+
+void TaskServer::Serve(int)
+{
+}
+
+TaskClient::~TaskClient() = default;
+
+bool TaskClient::Connect(const std::filesystem::path&)
+{
+    return false;
+}
+
+std::optional<TaskClient::Response> TaskClient::Send(std::string_view)
+{
+    return std::nullopt;
+}
+
+#else
+
+bool TaskServer::Run()
+{
+    const auto& path = m_options.socketPath;
+    sockaddr_un addr;
+    if (m_wakeFds[0] < 0 || !FillAddress(path, addr) || !PrepareDirectory(path.parent_path()))
+    {
+        std::cerr << "Error: cannot serve on " << path << std::endl;
+        SetReady(false);
+        return false;
+    }
+
+    // A live server answers, a stale socket file from a crash is replaced
+    if (int probe = ConnectTo(path); probe >= 0)
+    {
+        close(probe);
+        std::cerr << "Error: a server already listens on " << path << std::endl;
+        SetReady(false);
+        return false;
+    }
+    unlink(path.c_str());
+
+    // The socket file is created 0600; a chmod after bind would leave it
+    // open to other users until then
+    m_listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    bool bound = false;
+    if (m_listenFd >= 0)
+    {
+        mode_t mask = umask(S_IRWXG | S_IRWXO | S_IXUSR);
+        bound = bind(m_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+        umask(mask);
+    }
+    if (!bound || listen(m_listenFd, SOMAXCONN) != 0)
+    {
+        std::cerr << "Error: cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+        if (m_listenFd >= 0)
+            close(m_listenFd);
+        m_listenFd = -1;
+        SetReady(false);
+        return false;
+    }
+    SetCloseOnExec(m_listenFd);
+    SetReady(true);
+
+    using Clock = std::chrono::steady_clock;
+    const auto interval = m_options.flushInterval;
+    const auto syncInterval = m_options.syncInterval;
+    auto nextFlush = Clock::now() + interval;
+    auto nextSync = Clock::now() + syncInterval;
+    while (!m_stopping)
+    {
+        // Wake up for whichever timer is due first
+        int timeout = -1;
+        auto wait = [&](Clock::time_point due) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(due - Clock::now());
+            int ms = static_cast<int>(std::max<std::chrono::milliseconds::rep>(left.count(), 0));
+            timeout = timeout < 0 ? ms : std::min(timeout, ms);
+        };
+        if (interval.count() > 0)
+            wait(nextFlush);
+        if (syncInterval.count() > 0)
+            wait(nextSync);
+
+        pollfd fds[2] = {{m_listenFd, POLLIN, 0}, {m_wakeFds[0], POLLIN, 0}};
+        int ready = poll(fds, 2, timeout);
+        if (ready < 0 && errno != EINTR)
+        {
+            std::cerr << "Error: poll failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (m_stopping)
+            break;
+
+        if (ready > 0 && (fds[0].revents & POLLIN))
+        {
+            int fd = accept(m_listenFd, nullptr, nullptr);
+            if (fd >= 0 && !PeerIsUser(fd))
+            {
+                close(fd);
+            }
+            else if (fd >= 0)
+            {
+                SetCloseOnExec(fd);
+                std::lock_guard lock(m_clientsMutex);
+                try
+                {
+                    std::thread([this, fd] { Serve(fd); }).detach();
+                    m_clients.insert(fd);
+                    ++m_active;
+                }
+                catch (const std::system_error& e)
+                {
+                    std::cerr << "Error: cannot serve connection: " << e.what() << std::endl;
+                    close(fd);
+                }
+            }
+        }
+
+        if (interval.count() > 0 && Clock::now() >= nextFlush)
+        {
+            Flush(false);
+            nextFlush = Clock::now() + interval;
+        }
+        if (syncInterval.count() > 0 && Clock::now() >= nextSync)
+        {
+            SyncJournal();
+            nextSync = Clock::now() + syncInterval;
+        }
+    }
+
+    // Wake the connection threads blocked in recv and wait for them
+    {
+        std::lock_guard lock(m_clientsMutex);
+        for (int fd : m_clients)
+            shutdown(fd, SHUT_RDWR);
+    }
+    for (size_t active; (active = m_active) != 0;)
+        m_active.wait(active);
+    // The last thread notifies under the lock, let it leave
+    {
+        std::lock_guard lock(m_clientsMutex);
+    }
+    close(m_listenFd);
+    m_listenFd = -1;
+    unlink(path.c_str());
+    bool synced = SyncJournal();
+    return Flush(false) && synced;
+}
+
+void TaskServer::Serve(int fd)
+{
+    std::string buffer;
+    size_t scanned = 0;
+    while (true)
+    {
+        size_t end = buffer.find('\n', scanned);
+        if (end == std::string::npos)
+        {
+            scanned = buffer.size();
+            if (buffer.size() > MAX_REQUEST || !Receive(fd, buffer))
+                break;
+            continue;
+        }
+
+        std::string response = Handle(std::string_view(buffer).substr(0, end));
+        buffer.erase(0, end + 1);
+        scanned = 0;
+        if (!SendAll(fd, response))
+            break;
+    }
+
+    std::lock_guard lock(m_clientsMutex);
+    m_clients.erase(fd);
+    close(fd);
+    --m_active;
+    m_active.notify_all();
+}
+
+TaskClient::~TaskClient()
+{
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+bool TaskClient::Connect(const std::filesystem::path& path)
+{
+    if (m_fd >= 0)
+        close(m_fd);
+    m_buffer.clear();
+    m_fd = ConnectTo(path);
+    return m_fd >= 0;
+}
+
+std::optional<TaskClient::Response> TaskClient::Send(std::string_view line)
+{
+    auto fail = [this] {
+        close(m_fd);
+        m_fd = -1;
+        return std::nullopt;
+    };
+    if (m_fd < 0)
+        return std::nullopt;
+
+    std::string request(line);
+    request += '\n';
+    if (!SendAll(m_fd, request))
+        return fail();
+
+    size_t header = 0;
+    while ((header = m_buffer.find('\n')) == std::string::npos)
+    {
+        if (!Receive(m_fd, m_buffer))
+            return fail();
+    }
+
+    Response response;
+    std::string_view status(m_buffer.data(), header);
+    if (status.starts_with("OK "))
+        response.ok = true;
+    else if (!status.starts_with("ERR "))
+        return fail();
+    status.remove_prefix(status.find(' ') + 1);
+    size_t length = 0;
+    auto [end, ec] = std::from_chars(status.data(), status.data() + status.size(), length);
+    if (ec != std::errc{} || end != status.data() + status.size())
+        return fail();
+
+    while (m_buffer.size() < header + 1 + length)
+    {
+        if (!Receive(m_fd, m_buffer))
+            return fail();
+    }
+    response.output = m_buffer.substr(header + 1, length);
+    m_buffer.erase(0, header + 1 + length);
+    return response;
+}
+
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+#include "TaskList.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+// Protocol shared by TaskServer and TaskClient over a Unix domain socket.
+// A request is one command line in the batch grammar (see SplitCommandLine)
+// terminated by '\n'. The response is "OK <n>\n" or "ERR <n>\n" followed by
+// n bytes of command output. A connection may carry any number of requests.
+namespace TaskProtocol
+{
+    // $TASK_CLI_SOCKET, or task-tracker.sock in $XDG_RUNTIME_DIR or in a
+    // task-tracker-<uid> directory in the temp directory that the server
+    // creates with mode 0700
+    std::filesystem::path DefaultSocketPath();
+}
+
+// Keeps one TaskList in memory and runs task-cli commands against it.
+// List and search requests run concurrently, mutations one at a time.
+// Mutations are journaled by the list; the server folds them into the
+// store every flushInterval, on a "flush" request and when it stops, and
+// syncs journal records of incomplete commit groups every syncInterval.
+class TaskServer
+{
+public:
+    struct Options
+    {
+        std::filesystem::path socketPath = TaskProtocol::DefaultSocketPath();
+        // Zero flushes only on demand
+        std::chrono::milliseconds flushInterval{0};
+        // With a list that commits in groups, the journal records of an
+        // incomplete group are fsynced at least this often and on Stop().
+        // This bounds how long a reported mutation may be lost to a crash.
+        std::chrono::milliseconds syncInterval{0};
+    };
+
+    TaskServer(TaskList& tasks, Options options);
+    ~TaskServer();
+    TaskServer(const TaskServer&) = delete;
+    TaskServer& operator=(const TaskServer&) = delete;
+
+    // Serves until Stop() and flushes before returning. Fails if the socket
+    // cannot be bound or another server owns it. Connections from other
+    // users are closed unanswered.
+    bool Run();
+    // Safe to call from a signal handler or another thread
+    void Stop() noexcept;
+    // Blocks until Run() listens or failed, returns whether it listens
+    bool WaitReady();
+
+    // Runs one request line, returns the complete response
+    std::string Handle(std::string_view line);
+
+private:
+    void Serve(int fd);
+    // Without force only if a mutation ran since the last flush
+    bool Flush(bool force);
+    // fsyncs journal records of mutations handled since the last sync
+    bool SyncJournal();
+    void SetReady(bool listening);
+
+    TaskList& m_tasks;
+    Options m_options;
+    std::shared_mutex m_tasksMutex;
+    std::atomic<bool> m_dirty{false};
+    std::atomic<bool> m_unsynced{false};
+    std::atomic<bool> m_stopping{false};
+    int m_listenFd = -1;
+    int m_wakeFds[2] = {-1, -1};
+
+    // Connections are served on detached threads, tracked for shutdown
+    std::mutex m_clientsMutex;
+    std::unordered_set<int> m_clients;
+    std::atomic<size_t> m_active{0};
+    // 0 until Run() listens (1) or failed (2)
+    std::atomic<int> m_ready{0};
+};
+
+// Connection to a running TaskServer
+class TaskClient
+{
+public:
+    struct Response
+    {
+        bool ok = false;
+        std::string output;
+    };
+
+    TaskClient() noexcept = default;
+    ~TaskClient();
+    TaskClient(const TaskClient&) = delete;
+    TaskClient& operator=(const TaskClient&) = delete;
+
+    // Fails quietly if no server listens on path, or if the socket or the
+    // server behind it belongs to another user
+    bool Connect(const std::filesystem::path& path = TaskProtocol::DefaultSocketPath());
+    // Sends one request line, nullopt if the connection broke
+    std::optional<Response> Send(std::string_view line);
+    bool IsConnected() const noexcept { return m_fd >= 0; }
+
+private:
+    int m_fd = -1;
+    std::string m_buffer;
+};
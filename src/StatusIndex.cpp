@@ -0,0 +1,54 @@
+#include "StatusIndex.h"
+
+void StatusIndex::Assign(const std::vector<Task>& tasks)
+{
+    m_size = 0;
+    m_counts = {};
+    for (auto& bits : m_bits)
+        bits.assign((tasks.size() + 63) / 64, 0);
+
+    for (const auto& task : tasks)
+    {
+        size_t slot = Slot(task.GetStatus());
+        m_bits[slot][m_size / 64] |= uint64_t{1} << (m_size % 64);
+        ++m_counts[slot];
+        ++m_size;
+    }
+}
+
+void StatusIndex::PushBack(Task::Status status)
+{
+    if (m_size % 64 == 0)
+    {
+        for (auto& bits : m_bits)
+            bits.push_back(0);
+    }
+    size_t slot = Slot(status);
+    m_bits[slot][m_size / 64] |= uint64_t{1} << (m_size % 64);
+    ++m_counts[slot];
+    ++m_size;
+}
+
+void StatusIndex::Set(size_t pos, Task::Status from, Task::Status to) noexcept
+{
+    if (pos >= m_size || from == to)
+        return;
+    const uint64_t bit = uint64_t{1} << (pos % 64);
+    m_bits[Slot(from)][pos / 64] &= ~bit;
+    m_bits[Slot(to)][pos / 64] |= bit;
+    --m_counts[Slot(from)];
+    ++m_counts[Slot(to)];
+}
+
+void StatusIndex::Remove(size_t pos, Task::Status status) noexcept
+{
+    if (pos >= m_size)
+        return;
+    const uint64_t bit = uint64_t{1} << (pos % 64);
+    auto& word = m_bits[Slot(status)][pos / 64];
+    if (word & bit)
+    {
+        word &= ~bit;
+        --m_counts[Slot(status)];
+    }
+}
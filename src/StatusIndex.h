@@ -0,0 +1,63 @@
+#pragma once
+#include "Task.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One bitset per Task::Status over the slots of a task vector, plus a
+// running count per status. Listing a status skips 64 slots per empty word,
+// counting is O(1). A removed slot keeps its position with no bit set.
+class StatusIndex
+{
+public:
+    static constexpr size_t STATUS_COUNT = 3;
+
+    void Assign(const std::vector<Task>& tasks);
+    void PushBack(Task::Status status);
+    void Set(size_t pos, Task::Status from, Task::Status to) noexcept;
+    void Remove(size_t pos, Task::Status status) noexcept;
+    bool IsLive(size_t pos) const noexcept
+    {
+        const uint64_t bit = uint64_t{1} << (pos % 64);
+        return ((m_bits[0][pos / 64] | m_bits[1][pos / 64] | m_bits[2][pos / 64]) & bit) != 0;
+    }
+
+    bool Has(size_t pos, Task::Status status) const noexcept
+    {
+        return (m_bits[Slot(status)][pos / 64] >> (pos % 64)) & 1;
+    }
+
+    // Number of slots, removed ones included
+    size_t Size() const noexcept { return m_size; }
+    size_t Count(Task::Status status) const noexcept { return m_counts[Slot(status)]; }
+
+    // Calls fn with every position in [first, last) that has the status,
+    // in ascending order
+    template <typename Fn>
+    void ForEach(Task::Status status, size_t first, size_t last, Fn&& fn) const
+    {
+        const auto& bits = m_bits[Slot(status)];
+        for (size_t w = first / 64; w * 64 < last; ++w)
+        {
+            uint64_t word = bits[w];
+            if (w == first / 64)
+                word &= ~uint64_t{0} << (first % 64);
+            if ((w + 1) * 64 > last)
+                word &= ~uint64_t{0} >> (64 - last % 64);
+            while (word)
+            {
+                fn(w * 64 + static_cast<size_t>(std::countr_zero(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    static size_t Slot(Task::Status status) noexcept { return static_cast<size_t>(status); }
+
+    std::array<std::vector<uint64_t>, STATUS_COUNT> m_bits;
+    std::array<size_t, STATUS_COUNT> m_counts{};
+    size_t m_size = 0;
+};
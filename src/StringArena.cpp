@@ -0,0 +1,19 @@
+#include "StringArena.h"
+
+#include <cstring>
+
+std::string_view StringArena::Copy(std::string_view s)
+{
+    if (s.empty())
+        return {};
+    auto* data = static_cast<char*>(m_resource.allocate(s.size(), 1));
+    std::memcpy(data, s.data(), s.size());
+    m_used += s.size();
+    return {data, s.size()};
+}
+
+void StringArena::Release() noexcept
+{
+    m_resource.release();
+    m_used = 0;
+}
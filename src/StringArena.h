@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+// Bump allocator for strings that all die together, e.g. the descriptions
+// of a loaded store. Copies are packed into a few large blocks instead of
+// one heap allocation each; Release frees them all at once.
+class StringArena
+{
+public:
+    // The copy stays valid until Release or destruction
+    std::string_view Copy(std::string_view s);
+    void Release() noexcept;
+    size_t BytesUsed() const noexcept { return m_used; }
+
+private:
+    std::pmr::monotonic_buffer_resource m_resource;
+    size_t m_used = 0;
+};
@@ -0,0 +1,258 @@
+#include "SubstringScan.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define SUBSTRING_SCAN_X86 1
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define TARGET_AVX2
+    #else
+        #define TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+namespace
+{
+    using SubstringScan::Isa;
+
+    constexpr size_t NPOS = std::string_view::npos;
+
+    inline char Lower(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+    }
+
+    // needle is already folded when Fold is set
+    template <bool Fold>
+    bool Equal(const char* text, const char* needle, size_t n) noexcept
+    {
+        if constexpr (!Fold)
+            return std::memcmp(text, needle, n) == 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (Lower(text[i]) != needle[i])
+                return false;
+        }
+        return true;
+    }
+
+    template <bool Fold>
+    size_t FindScalar(const char* h, size_t size, const char* needle, size_t n, size_t from) noexcept
+    {
+        // The library search is memchr based and hard to beat without folding
+        if constexpr (!Fold)
+            return std::string_view(h, size).find(std::string_view(needle, n), from);
+        for (size_t i = from; i + n <= size; ++i)
+        {
+            if ((Fold ? Lower(h[i]) : h[i]) == needle[0] && Equal<Fold>(h + i + 1, needle + 1, n - 1))
+                return i;
+        }
+        return NPOS;
+    }
+
+#ifdef SUBSTRING_SCAN_X86
+    // 'A'..'Z' are shifted to the bottom of the signed range, so one signed
+    // compare finds them
+    template <bool Fold>
+    __m128i Load16(const char* p) noexcept
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        if constexpr (Fold)
+        {
+            __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(128 - 'A')));
+            __m128i upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + 26)));
+            v = _mm_add_epi8(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+        }
+        return v;
+    }
+
+    template <bool Fold>
+    size_t FindSse2(const char* h, size_t size, const char* needle, size_t n) noexcept
+    {
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[n - 1]);
+        const size_t middle = n >= 2 ? n - 2 : 0;
+
+        size_t i = 0;
+        for (; i + n - 1 + 16 <= size; i += 16)
+        {
+            __m128i eqFirst = _mm_cmpeq_epi8(first, Load16<Fold>(h + i));
+            __m128i eqLast = _mm_cmpeq_epi8(last, Load16<Fold>(h + i + n - 1));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(eqFirst, eqLast)));
+            while (mask)
+            {
+                size_t pos = i + static_cast<size_t>(std::countr_zero(mask));
+                if (Equal<Fold>(h + pos + 1, needle + 1, middle))
+                    return pos;
+                mask &= mask - 1;
+            }
+        }
+        return FindScalar<Fold>(h, size, needle, n, i);
+    }
+
+    template <bool Fold>
+    TARGET_AVX2 __m256i Load32(const char* p) noexcept
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        if constexpr (Fold)
+        {
+            __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(128 - 'A')));
+            __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + 26)), shifted);
+            v = _mm256_add_epi8(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+        }
+        return v;
+    }
+
+    template <bool Fold>
+    TARGET_AVX2 size_t FindAvx2(const char* h, size_t size, const char* needle, size_t n) noexcept
+    {
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[n - 1]);
+        const size_t middle = n >= 2 ? n - 2 : 0;
+
+        size_t i = 0;
+        for (; i + n - 1 + 32 <= size; i += 32)
+        {
+            __m256i eqFirst = _mm256_cmpeq_epi8(first, Load32<Fold>(h + i));
+            __m256i eqLast = _mm256_cmpeq_epi8(last, Load32<Fold>(h + i + n - 1));
+            uint32_t mask = static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_and_si256(eqFirst, eqLast)));
+            while (mask)
+            {
+                size_t pos = i + static_cast<size_t>(std::countr_zero(mask));
+                if (Equal<Fold>(h + pos + 1, needle + 1, middle))
+                    return pos;
+                mask &= mask - 1;
+            }
+        }
+        size_t tail = FindSse2<Fold>(h + i, size - i, needle, n);
+        return tail == NPOS ? NPOS : i + tail;
+    }
+
+    bool CpuHasAvx2() noexcept
+    {
+        #ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+            __cpuid(info, 1);
+            // OSXSAVE and AVX, then the OS has to save the YMM state
+            if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0
+                || (_xgetbv(0) & 0x6) != 0x6)
+                return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+        #else
+            return __builtin_cpu_supports("avx2");
+        #endif
+    }
+#endif
+
+    template <bool Fold>
+    size_t Dispatch(const char* h, size_t size, const char* needle, size_t n, Isa isa) noexcept
+    {
+        #ifdef SUBSTRING_SCAN_X86
+            if (isa == Isa::AVX2)
+                return FindAvx2<Fold>(h, size, needle, n);
+            if (isa == Isa::SSE2)
+                return FindSse2<Fold>(h, size, needle, n);
+        #else
+            (void)isa;
+        #endif
+        return FindScalar<Fold>(h, size, needle, n, 0);
+    }
+}
+
+Isa SubstringScan::Detected() noexcept
+{
+    #ifdef SUBSTRING_SCAN_X86
+        static const Isa isa = CpuHasAvx2() ? Isa::AVX2 : Isa::SSE2;
+        return isa;
+    #else
+        return Isa::SCALAR;
+    #endif
+}
+
+size_t SubstringScan::Find(std::string_view haystack, std::string_view needle, bool ignoreCase,
+    Isa isa) noexcept
+{
+    if (needle.empty())
+        return 0;
+    if (needle.size() > haystack.size())
+        return NPOS;
+
+    if (!ignoreCase)
+        return Dispatch<false>(haystack.data(), haystack.size(), needle.data(), needle.size(), isa);
+
+    // Short fragments are folded on the stack, longer ones on the heap
+    char small[64];
+    std::string large;
+    char* folded = small;
+    if (needle.size() > sizeof(small))
+    {
+        large.resize(needle.size());
+        folded = large.data();
+    }
+    std::transform(needle.begin(), needle.end(), folded, Lower);
+    return Dispatch<true>(haystack.data(), haystack.size(), folded, needle.size(), isa);
+}
+
+void SubstringScan::Corpus::Clear() noexcept
+{
+    m_data.clear();
+    m_starts.clear();
+}
+
+void SubstringScan::Corpus::Reserve(size_t texts, size_t bytes)
+{
+    m_starts.reserve(texts);
+    m_data.reserve(bytes + texts);
+}
+
+void SubstringScan::Corpus::Add(std::string_view text)
+{
+    m_starts.push_back(m_data.size());
+    m_data.append(text);
+    m_data.push_back('\0');
+}
+
+void SubstringScan::Corpus::FindAll(std::string_view needle, bool ignoreCase,
+    const std::function<void(size_t)>& fn, Isa isa) const
+{
+    const std::string_view data = m_data;
+    size_t pos = 0;
+    size_t text = 0;
+    while (pos < data.size())
+    {
+        size_t hit = Find(data.substr(pos), needle, ignoreCase, isa);
+        if (hit == NPOS)
+            return;
+        hit += pos;
+
+        // Texts are in order, so the owning text is found by walking forward
+        // from the last one, with a binary search for long gaps
+        if (text + 8 < m_starts.size() && m_starts[text + 8] <= hit)
+            text = static_cast<size_t>(std::upper_bound(m_starts.begin() + text, m_starts.end(), hit)
+                - m_starts.begin()) - 1;
+        while (text + 1 < m_starts.size() && m_starts[text + 1] <= hit)
+            ++text;
+
+        size_t end = text + 1 < m_starts.size() ? m_starts[text + 1] - 1 : data.size() - 1;
+        if (hit + needle.size() <= end)
+        {
+            fn(text);
+            pos = end + 1;
+            ++text;
+        }
+        else
+        {
+            // Match runs across the separator into the next text
+            pos = hit + 1;
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Brute-force substring search for fragments the keyword index cannot
+// answer. Candidates are found by comparing the first and last needle byte
+// against 16 (SSE2) or 32 (AVX2) haystack positions at once; only those are
+// verified. The instruction set is picked at runtime.
+namespace SubstringScan
+{
+    enum class Isa
+    {
+        SCALAR, SSE2, AVX2
+    };
+
+    // Best instruction set supported by this CPU and build
+    Isa Detected() noexcept;
+
+    // Offset of the first occurrence of needle, or npos. ignoreCase folds
+    // ASCII letters only.
+    size_t Find(std::string_view haystack, std::string_view needle, bool ignoreCase,
+        Isa isa = Detected()) noexcept;
+
+    // Texts packed back to back in one buffer, so a search is a single
+    // sequential pass instead of one pointer chase per text
+    class Corpus
+    {
+    public:
+        void Clear() noexcept;
+        void Reserve(size_t texts, size_t bytes);
+        void Add(std::string_view text);
+        size_t Size() const noexcept { return m_starts.size(); }
+
+        // Calls fn with the position of every text that contains needle,
+        // in ascending order
+        void FindAll(std::string_view needle, bool ignoreCase,
+            const std::function<void(size_t)>& fn, Isa isa = Detected()) const;
+
+    private:
+        std::string m_data;
+        // Start of every text in m_data; texts are separated by one '\0'
+        std::vector<size_t> m_starts;
+    };
+}
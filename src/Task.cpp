@@ -1,23 +1,17 @@
 #include "Task.h"
+#include "JsonWriter.h"
+#include "TimeCodec.h"
 #include <chrono>
-#include <ctime>
-#include <iomanip>
 #include <iostream>
 #include <ostream>
-#include <sstream>
 
 namespace chrono = std::chrono;
 
 std::ostream& operator<<(std::ostream& os, chrono::system_clock::time_point tp)
 {
-    std::time_t t = chrono::system_clock::to_time_t(tp);
-    std::tm tm;
-    #ifdef _WIN32
-        localtime_s(&tm, &t);
-    #else
-        localtime_r(&t, &tm);
-    #endif
-    os << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+    char buf[TimeCodec::TIMESTAMP_SIZE];
+    TimeCodec::Format(tp, buf);
+    os.write(buf, sizeof(buf));
     return os;
 }
 
@@ -35,7 +29,44 @@ Task::Task(int id, std::string_view description, Status status,
 
 }
 
+Task Task::Borrowing(int id, std::string_view description, Status status, 
+        std::chrono::system_clock::time_point createdAt, 
+        std::optional<std::chrono::system_clock::time_point> updatedAt)
+{
+    Task task(id, std::string_view{}, status, createdAt, updatedAt);
+    task.m_borrowedDescription = description;
+    task.m_isBorrowed = true;
+    return task;
+}
+
+Task::Task(const Task& other)
+    : m_id(other.m_id), m_description(other.GetDescription()), m_status(other.m_status), 
+      m_createdAt(other.m_createdAt), m_updatedAt(other.m_updatedAt)
+{
+
+}
+
+Task& Task::operator=(const Task& other)
+{
+    if (this != &other)
+    {
+        m_id = other.m_id;
+        m_description = other.GetDescription();
+        m_borrowedDescription = {};
+        m_isBorrowed = false;
+        m_status = other.m_status;
+        m_createdAt = other.m_createdAt;
+        m_updatedAt = other.m_updatedAt;
+    }
+    return *this;
+}
+
 bool Task::UpdateTask(std::string_view description)
+{
+    return UpdateTask(description, chrono::system_clock::now());
+}
+
+bool Task::UpdateTask(std::string_view description, chrono::system_clock::time_point updatedAt)
 {
     if (description.empty())
     {
@@ -48,15 +79,23 @@ bool Task::UpdateTask(std::string_view description)
         return false;
     }
         
+    // Copy-on-write: the borrowed bytes are left untouched
     m_description = description;
-    m_updatedAt = chrono::system_clock::now();
+    m_borrowedDescription = {};
+    m_isBorrowed = false;
+    m_updatedAt = updatedAt;
     return true;
 }
 
 void Task::MarkTask(Status status)
+{
+    MarkTask(status, chrono::system_clock::now());
+}
+
+void Task::MarkTask(Status status, chrono::system_clock::time_point updatedAt)
 {
     m_status = status;
-    m_updatedAt = chrono::system_clock::now();
+    m_updatedAt = updatedAt;
 }
 
 void Task::PrintTask(std::ostream& stream) const noexcept
@@ -75,29 +114,26 @@ void Task::PrintTask(std::ostream& stream) const noexcept
 
 void Task::ToJson(std::ostream& stream, int indent) const
 {
-    const std::string ind(indent, ' ');
-    stream  << ind << "{\n"
-            << ind << "    \"id\": " << m_id << ",\n"
-            << ind << "    \"description\": " << "\"" << m_description << "\",\n"
-            << ind << "    \"status\": " << "\"" << toString(GetStatus()) << "\",\n"
-            << ind << "    \"createdAt\": " << "\"" << m_createdAt << "\",\n"
-            << ind << "    \"updatedAt\": " << "\"" << GetUpdatedAtString() << "\"\n"
-            << ind << "}";
+    thread_local JsonWriter writer;
+    writer.Clear();
+    writer.AppendTask(*this, indent);
+    auto out = writer.View();
+    stream.write(out.data(), static_cast<std::streamsize>(out.size()));
 }
 
 std::string Task::GetCreatedAtString() const
 {
-    std::ostringstream oss;
-    oss << m_createdAt;
-    return oss.str();
+    char buf[TimeCodec::TIMESTAMP_SIZE];
+    TimeCodec::Format(m_createdAt, buf);
+    return std::string(buf, sizeof(buf));
 }
 
 std::string Task::GetUpdatedAtString() const
 {
     if (m_updatedAt.has_value()) {
-        std::ostringstream oss;
-        oss << m_updatedAt.value();
-        return oss.str();
+        char buf[TimeCodec::TIMESTAMP_SIZE];
+        TimeCodec::Format(m_updatedAt.value(), buf);
+        return std::string(buf, sizeof(buf));
     }
     return "null";
 }
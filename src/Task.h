@@ -18,11 +18,23 @@ public:
         std::chrono::system_clock::time_point createdAt, 
         std::optional<std::chrono::system_clock::time_point> updatedAt);
 
+    // Borrows the description instead of copying it. The referenced bytes
+    // must outlive the task; copies and description updates detach it.
+    static Task Borrowing(int id, std::string_view description, Status status, 
+        std::chrono::system_clock::time_point createdAt, 
+        std::optional<std::chrono::system_clock::time_point> updatedAt);
+
     ~Task() = default;
+    Task(const Task& other);
+    Task& operator=(const Task& other);
+    Task(Task&&) noexcept = default;
+    Task& operator=(Task&&) noexcept = default;
 
     // change task
     bool UpdateTask(std::string_view description);
+    bool UpdateTask(std::string_view description, std::chrono::system_clock::time_point updatedAt);
     void MarkTask(Status status);
+    void MarkTask(Status status, std::chrono::system_clock::time_point updatedAt);
 
     // helper
     void PrintTask(std::ostream& stream) const noexcept;
@@ -41,7 +53,11 @@ public:
     
     // Getter
     int GetId() const noexcept { return m_id; };
-    std::string_view GetDescription() const { return m_description; };
+    std::string_view GetDescription() const 
+    { 
+        return m_isBorrowed ? m_borrowedDescription : std::string_view{m_description}; 
+    };
+    bool IsBorrowed() const noexcept { return m_isBorrowed; };
     constexpr Status GetStatus() const noexcept { return m_status; };
     std::chrono::system_clock::time_point GetCreatedAt() const { return m_createdAt; };
     std::optional<std::chrono::system_clock::time_point> GetUpdatedAt() const { return m_updatedAt; };
@@ -57,6 +73,8 @@ public:
 private:
     int         m_id;
     std::string m_description;
+    std::string_view m_borrowedDescription;
+    bool        m_isBorrowed = false;
     Status      m_status;
     std::chrono::system_clock::time_point m_createdAt;
     std::optional<std::chrono::system_clock::time_point> m_updatedAt;
@@ -0,0 +1,38 @@
+#include "TaskColumns.h"
+
+namespace
+{
+    TaskColumns::Rep UpdatedRep(const Task& task) noexcept
+    {
+        auto updated = task.GetUpdatedAt();
+        return updated ? TaskColumns::ToRep(*updated) : TaskColumns::NEVER;
+    }
+}
+
+void TaskColumns::Assign(const std::vector<Task>& tasks)
+{
+    m_ids.clear();
+    m_createdAt.clear();
+    m_updatedAt.clear();
+    m_ids.reserve(tasks.size());
+    m_createdAt.reserve(tasks.size());
+    m_updatedAt.reserve(tasks.size());
+    for (const auto& task : tasks)
+        PushBack(task);
+}
+
+void TaskColumns::PushBack(const Task& task)
+{
+    m_ids.push_back(task.GetId());
+    m_createdAt.push_back(ToRep(task.GetCreatedAt()));
+    m_updatedAt.push_back(UpdatedRep(task));
+}
+
+void TaskColumns::Set(size_t pos, const Task& task) noexcept
+{
+    if (pos >= m_ids.size())
+        return;
+    m_ids[pos] = task.GetId();
+    m_createdAt[pos] = ToRep(task.GetCreatedAt());
+    m_updatedAt[pos] = UpdatedRep(task);
+}
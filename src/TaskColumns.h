@@ -0,0 +1,39 @@
+#pragma once
+#include "Task.h"
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+// The scalar fields of the slots of a task vector, one contiguous array per
+// field. A scan over ids or timestamps reads 4 or 8 bytes per task instead of
+// pulling whole Tasks, descriptions included, through the cache. Statuses
+// are kept packed by StatusIndex. A removed slot keeps its values.
+class TaskColumns
+{
+public:
+    using Rep = std::chrono::system_clock::rep;
+    // updatedAt of a task that was never updated
+    static constexpr Rep NEVER = std::numeric_limits<Rep>::min();
+
+    static Rep ToRep(std::chrono::system_clock::time_point tp) noexcept
+    {
+        return tp.time_since_epoch().count();
+    }
+
+    void Assign(const std::vector<Task>& tasks);
+    void PushBack(const Task& task);
+    // Refreshes a slot after its task changed
+    void Set(size_t pos, const Task& task) noexcept;
+
+    size_t Size() const noexcept { return m_ids.size(); }
+    std::span<const int> Ids() const noexcept { return m_ids; }
+    std::span<const Rep> CreatedAt() const noexcept { return m_createdAt; }
+    std::span<const Rep> UpdatedAt() const noexcept { return m_updatedAt; }
+
+private:
+    std::vector<int> m_ids;
+    std::vector<Rep> m_createdAt;
+    std::vector<Rep> m_updatedAt;
+};
@@ -1,12 +1,18 @@
 #include "TaskList.h"
 #include "Task.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "KeywordIndex.h"
+#include "BinarySnapshot.h"
+#include "TimeCodec.h"
 
 #include <algorithm>
-#include <cctype>
 #include <chrono>
+#include <charconv>
+#include <cstring>
 #include <ctime>
-#include <direct.h>
-#include <fstream>
+#include <functional>
+#include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <limits.h>
@@ -15,8 +21,119 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <vector>
 
+namespace
+{
+    // Smallest share of a JSON store worth a load thread of its own
+    constexpr size_t MIN_LOAD_CHUNK_BYTES = 4 << 20;
+    // Same for saving, in tasks
+    constexpr size_t MIN_SAVE_CHUNK_TASKS = 1 << 14;
+
+    // Threads for a loadThreads/saveThreads option, 0 is one per core
+    size_t ThreadCount(unsigned option) noexcept
+    {
+        return option ? option : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Calls fn(k) for k in [0, count), each on its own thread; 0 runs on
+    // the caller
+    template <typename Fn>
+    void RunChunks(size_t count, Fn&& fn)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(count - 1);
+        for (size_t k = 1; k < count; ++k)
+            threads.emplace_back(std::ref(fn), k);
+        fn(size_t{0});
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    // Each chunk of tasks is formatted into a buffer of its own, then every
+    // buffer is written at the offset the ones before it add up to
+    bool WriteChunks(const std::vector<Task>& tasks, OutputFile& file, size_t chunks,
+        std::string_view open, std::string_view close)
+    {
+        std::vector<JsonWriter> buffers(chunks);
+        RunChunks(chunks, [&](size_t k)
+        {
+            const size_t begin = tasks.size() * k / chunks;
+            const size_t end = tasks.size() * (k + 1) / chunks;
+            JsonWriter& writer = buffers[k];
+            if (k == 0)
+                writer.Append(open);
+            for (size_t i = begin; i < end; ++i)
+            {
+                writer.AppendTask(tasks[i], 4);
+                writer.Append(i + 1 < tasks.size() ? ",\n" : "\n");
+            }
+            if (k + 1 == chunks)
+                writer.Append(close);
+        });
+
+        std::vector<uint64_t> offsets(chunks, 0);
+        for (size_t k = 1; k < chunks; ++k)
+            offsets[k] = offsets[k - 1] + buffers[k - 1].Size();
+        // Not vector<bool>, threads set neighbouring elements
+        std::vector<char> written(chunks, 0);
+        RunChunks(chunks, [&](size_t k)
+        {
+            written[k] = file.WriteAt(buffers[k].View(), offsets[k]);
+        });
+        return std::all_of(written.begin(), written.end(), [](char ok) { return ok != 0; });
+    }
+
+    // Next id a store keeps, 0 if it leaves it to the ids of its tasks
+    int StoredNextId(std::string_view store)
+    {
+        if (BinarySnapshot::IsBinary(store))
+            return BinarySnapshot::NextId(store);
+        JsonReader reader{store};
+        int nextId = 0;
+        if (reader.BeginArray())
+        {
+            auto value = reader.NextId();
+            std::from_chars(value.data(), value.data() + value.size(), nextId);
+        }
+        return std::max(nextId, 0);
+    }
+
+    bool IsJsonWhitespace(char c) noexcept
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    // Start of the first task object at or after offset: a '{' preceded by
+    // ',' and '}', ignoring whitespace. json.size() if there is none. The
+    // pattern may also occur inside a description; ParseTasksParallel
+    // notices that and does not trust the split.
+    size_t NextObjectStart(std::string_view json, size_t offset) noexcept
+    {
+        while (offset < json.size())
+        {
+            const void* hit = std::memchr(json.data() + offset, '{', json.size() - offset);
+            if (!hit)
+                break;
+            const size_t brace = static_cast<const char*>(hit) - json.data();
+            size_t i = brace;
+            while (i > 0 && IsJsonWhitespace(json[i - 1]))
+                --i;
+            if (i > 0 && json[i - 1] == ',')
+            {
+                --i;
+                while (i > 0 && IsJsonWhitespace(json[i - 1]))
+                    --i;
+                if (i > 0 && json[i - 1] == '}')
+                    return brace;
+            }
+            offset = brace + 1;
+        }
+        return json.size();
+    }
+}
+
 #ifdef _WIN32
     #define WIN32_LEAN_AND_MEAN
     #include <Windows.h>
@@ -25,91 +142,170 @@
     #include <limits.h>
 #endif
 
-TaskList::TaskList(const std::filesystem::path& jsonPath)
+TaskList::TaskList(const std::filesystem::path& jsonPath, TaskListOptions options)
+    : options_(options)
 {
-    LoadFromFile(jsonPath);
+    if (options_.format != TaskListOptions::Format::AUTO)
+        saveFormat_ = options_.format;
+
+    auto exeDir = GetExecutablePath();
+    g_taskListPath = exeDir / jsonPath;
+
+    // Without a lock file, e.g. in a read-only directory, the store is
+    // used unguarded
+    auto lockPath = g_taskListPath;
+    lockPath += ".lock";
+    storeLock_.Open(lockPath);
+    auto lock = storeLock_.Acquire(FileLock::Mode::SHARED);
+    Load();
 }
 
 TaskList::~TaskList()
 {
-    // Only write to file if there are tasks to save
-    if (!tasks_.empty())
+    if (journal_)
+    {
+        // Fold the journal into the store once it grew past the threshold,
+        // but leave that to a list that changed something
+        bool compact = dirty_ && (journalFailed_ 
+            || journal_->SizeBytes() >= options_.journalCompactBytes);
+        if (!compact)
+        {
+            // The rest of an incomplete commit group
+            journal_->Sync();
+            return;
+        }
+        auto lock = storeLock_.Acquire(FileLock::Mode::EXCLUSIVE);
+        Sync();
+        CompactSlots();
+        DecodeAll();
+        if (auto tmp = snapshotValid_ ? WriteTempFile(tasks_, g_taskListPath, saveFormat_) : std::nullopt)
+        {
+            tasks_.clear();
+            mapping_.Close();
+            // A crash before Clear() is harmless, replaying is idempotent
+            if (AtomicReplace(g_taskListPath, *tmp))
+                journal_->Clear();
+        }
+        return;
+    }
+
+    if (!dirty_)
+        return;
+    // Another process may have replaced the store since it was read
+    auto lock = storeLock_.Acquire(FileLock::Mode::EXCLUSIVE);
+    if (FileStamp::Of(g_taskListPath) != storeStamp_)
     {
-        WriteVectorToFile(tasks_);
-        AtomicReplace(g_taskListPath, g_taskListPathTmp);
+        if (touched_.empty())
+            return;
+        MergeTouched();
+    }
+
+    // Also when the last task was removed, an empty store is written then
+    CompactSlots();
+    DecodeAll();
+    if (auto tmp = WriteTempFile(tasks_, g_taskListPath, saveFormat_))
+    {
+        // Borrowed descriptions point into the mapping, drop both before
+        // the store is replaced
+        tasks_.clear();
+        mapping_.Close();
+        AtomicReplace(g_taskListPath, *tmp);
     }
 }
 
-bool TaskList::AddTask(std::string_view desc)
+bool TaskList::AddTask(std::string_view desc, std::ostream& err)
 {
     // Validate input
     if (desc.empty()) 
     {
+        err << "Error: Description is missing" << std::endl;
         return false;
     }
     
     // Check for reasonable length
     if (desc.length() > 1000) 
     {
+        err << "Error: Description must be < 1000 characters" << std::endl;
         return false;
     }
     
     // Perform operation
-    Task task = Task(tasks_.size() + 1, desc);
-    tasks_.push_back(std::move(task));
+    auto lock = BeginWrite();
+    AppendSlot(Task(nextId_, desc));
     
+    const Task& added = tasks_.back();
+    LogRecord({Journal::Record::Type::ADD, added.GetId(), added.GetStatus(), 
+        added.GetCreatedAt(), added.GetDescription()});
     return true;
 }
 
-bool TaskList::UpdateTask(size_t index, std::string desc)
+bool TaskList::UpdateTask(int id, std::string desc, std::ostream& err)
 {
-    // Validate bounds
-    if (index >= tasks_.size()) 
+    auto lock = BeginWrite();
+    auto slot = FindIndexById(id);
+    if (!slot) 
     {
-        std::cerr << "Error: Index greater than number of tasks" << std::endl;
+        err << "Error: Task with id " << id << " does not exist" << std::endl;
         return false;
     }
-    
-    if (index < 0)
+
+    // Validate input, Task::UpdateTask would report to std::cerr
+    if (desc.empty()) 
     {
-        std::cerr << "Error: Negative index is not a valid index" << std::endl;
+        err << "Error: Description is missing" << std::endl;
         return false;
     }
-
-    // Validate input
-    if (desc.empty()) 
+    if (desc.length() > 1000) 
     {
-        std::cerr << "Error: Description is missing" << std::endl;
+        err << "Error: Description must be < 1000 characters" << std::endl;
         return false;
     }
     
     // Delegate to Task class
-    return tasks_[index].UpdateTask(desc);
+    DecodeSlot(*slot);
+    Task& task = tasks_[*slot];
+    std::string oldDesc{task.GetDescription()};
+    if (!task.UpdateTask(desc))
+        return false;
+    columns_.Set(*slot, task);
+    if (index_)
+    {
+        index_->Remove(task.GetId(), oldDesc);
+        index_->Add(task.GetId(), task.GetDescription());
+    }
+    corpusValid_ = false;
+    
+    LogRecord({Journal::Record::Type::UPDATE, task.GetId(), task.GetStatus(), 
+        *task.GetUpdatedAt(), task.GetDescription()});
+    return true;
 }
 
-bool TaskList::RemoveTask(size_t index)
+bool TaskList::RemoveTask(int id, std::ostream& err)
 {
-    // Validate bounds
-    if (index >= tasks_.size()) 
+    auto lock = BeginWrite();
+    auto slot = FindIndexById(id);
+    if (!slot) 
     {
+        err << "Error: Task with id " << id << " does not exist" << std::endl;
         return false;
     }
     
-    // Check if vector is not empty
-    if (tasks_.empty()) 
-    {
-        return false;
-    }
+    KillSlot(*slot);
+    // Compact once half the slots are dead, amortized O(1) per removal
+    if (deadSlots_ >= 64 && deadSlots_ * 2 >= tasks_.size())
+        CompactSlots();
     
-    tasks_.erase(tasks_.begin() + index);
+    LogRecord({Journal::Record::Type::DELETE, id, Task::Status::TODO, {}, {}});
     return true;
 }
 
-bool TaskList::MarkTask(size_t index, Task::Status status)
+bool TaskList::MarkTask(int id, Task::Status status, std::ostream& err)
 {
-    // Validate bounds
-    if (index >= tasks_.size()) 
+    auto lock = BeginWrite();
+    auto slot = FindIndexById(id);
+    if (!slot) 
     {
+        err << "Error: Task with id " << id << " does not exist" << std::endl;
         return false;
     }
     
@@ -121,11 +317,18 @@ bool TaskList::MarkTask(size_t index, Task::Status status)
         return false;
     }
     
-    tasks_[index].MarkTask(status);
+    DecodeSlot(*slot);
+    Task& task = tasks_[*slot];
+    statusIndex_.Set(*slot, task.GetStatus(), status);
+    task.MarkTask(status);
+    columns_.Set(*slot, task);
+    
+    LogRecord({Journal::Record::Type::MARK, task.GetId(), status, 
+        *task.GetUpdatedAt(), {}});
     return true;
 }
 
-bool TaskList::ListTasks(std::string s)
+bool TaskList::ListTasks(std::string_view s, std::ostream& out) const
 {
     std::optional<Task::Status> status = ParseStatus(s);
     if (status)
@@ -133,50 +336,261 @@ bool TaskList::ListTasks(std::string s)
         auto tasks = GetByStatus(status.value());
         if (tasks.empty()) 
         {
-            std::cout << "No tasks found with status: " << s << std::endl;
+            out << "No tasks found with status: " << s << std::endl;
             return true;  // Not an error, just no results
         }
         
-        for (auto task : tasks)
+        TaskPrinter printer(out);
+        for (auto const& task : tasks)
         {
-            task.PrintTask(std::cout);
+            printer.Print(task);
         }
     }
     else 
     {
-        PrintAllTasks();
+        PrintAllTasks(out);
     }
     
     return true;
 }
 
-void TaskList::PrintAllTasks() const
+bool TaskList::ListTasks(std::string_view s, const TaskOrder& order, std::ostream& out, 
+    TaskPrinter::Format format) const
 {
-    for (auto const& task : tasks_)
+    TaskFilter filter;
+    filter.status = ParseStatus(s);
+    auto tasks = Select(filter, order);
+    if (tasks.empty() && filter.status)
     {
-        task.PrintTask(std::cout);
+        out << "No tasks found with status: " << s << std::endl;
+        return true;
     }
+    TaskPrinter printer(out, format);
+    for (auto const& task : tasks)
+    {
+        printer.Print(task);
+    }
+    return true;
 }
 
-std::vector<Task> TaskList::GetByStatus(Task::Status s) const
+void TaskList::PrintAllTasks(std::ostream& out) const
 {
-    std::vector<Task> out;
-    for (auto const& task : tasks_)
+    DecodeAll();
+    TaskPrinter printer(out);
+    for (size_t i = 0; i < tasks_.size(); ++i)
     {
-        if (task.GetStatus() == s)
-            out.push_back(task);
+        if (statusIndex_.IsLive(i))
+            printer.Print(tasks_[i]);
     }
-    return out;
 }
 
-std::vector<Task> TaskList::FindByKeyWord(std::string_view word) const
+TaskView TaskList::Select(const TaskFilter& filter) const
+{
+    return TaskView(Match(filter));
+}
+
+TaskView TaskList::Select(const TaskFilter& filter, const TaskOrder& order) const
+{
+    std::vector<const Task*> out = Match(filter);
+    const size_t first = std::min(order.offset, out.size());
+    const size_t last = out.size() - first > order.limit ? first + order.limit : out.size();
+
+    // Matches come in slot order, which is id order while ids are sorted
+    bool sorted = order.key == TaskOrder::Key::ID && !order.descending && idsSorted_;
+    auto sortBy = [&](auto column)
+    {
+        auto before = [&](const Task* a, const Task* b)
+        {
+            size_t slotA = static_cast<size_t>(a - tasks_.data());
+            size_t slotB = static_cast<size_t>(b - tasks_.data());
+            if (column[slotA] != column[slotB])
+                return order.descending ? column[slotA] > column[slotB] : column[slotA] < column[slotB];
+            // Ties keep list order
+            return slotA < slotB;
+        };
+        if (last < out.size())
+            std::nth_element(out.begin(), out.begin() + last, out.end(), before);
+        std::sort(out.begin(), out.begin() + last, before);
+    };
+    if (!sorted)
+    {
+        switch (order.key)
+        {
+            case TaskOrder::Key::ID: sortBy(columns_.Ids()); break;
+            case TaskOrder::Key::CREATED: sortBy(columns_.CreatedAt()); break;
+            case TaskOrder::Key::UPDATED: sortBy(columns_.UpdatedAt()); break;
+        }
+    }
+    out.erase(out.begin() + last, out.end());
+    out.erase(out.begin(), out.begin() + first);
+    return TaskView(std::move(out));
+}
+
+std::vector<const Task*> TaskList::Match(const TaskFilter& filter) const
 {
-    std::vector<Task> out;
-    // TODO:
+    DecodeAll();
+    std::vector<int> ids;
+    int minId = filter.minId;
+    int maxId = filter.maxId;
+    if (!filter.keywords.empty())
+    {
+        ids = QueryKeywords(filter.keywords);
+        if (ids.empty())
+            return {};
+        minId = std::max(minId, ids.front());
+        maxId = std::min(maxId, ids.back());
+    }
+    if (minId > maxId)
+        return {};
+
+    // Until a slot matches only the columns and status bits are read
+    using TimePoint = std::chrono::system_clock::time_point;
+    const bool byCreated = filter.createdFrom != TimePoint::min() || filter.createdTo != TimePoint::max();
+    const bool byUpdated = filter.updatedFrom != TimePoint::min() || filter.updatedTo != TimePoint::max();
+    const auto createdFrom = TaskColumns::ToRep(filter.createdFrom);
+    const auto createdTo = TaskColumns::ToRep(filter.createdTo);
+    const auto updatedFrom = TaskColumns::ToRep(filter.updatedFrom);
+    const auto updatedTo = TaskColumns::ToRep(filter.updatedTo);
+    const auto idColumn = columns_.Ids();
+    const auto created = columns_.CreatedAt();
+    const auto updated = columns_.UpdatedAt();
+    auto matches = [&](size_t slot) {
+        return (!filter.status || statusIndex_.Has(slot, *filter.status))
+            && idColumn[slot] >= minId && idColumn[slot] <= maxId
+            && (!byCreated || (created[slot] >= createdFrom && created[slot] <= createdTo))
+            && (!byUpdated || (updated[slot] != TaskColumns::NEVER 
+                && updated[slot] >= updatedFrom && updated[slot] <= updatedTo));
+    };
+
+    std::vector<const Task*> out;
+    // Keyword hits come sorted by id like tasks_, look them up instead of
+    // walking every task
+    if (!ids.empty() && idsSorted_)
+    {
+        for (int id : ids)
+        {
+            auto slot = FindIndexById(id);
+            if (slot && matches(*slot))
+                out.push_back(&tasks_[*slot]);
+        }
+        return out;
+    }
+
+    // With sorted ids the id range narrows the scan to a slice of the slots
+    size_t first = 0;
+    size_t last = idColumn.size();
+    if (idsSorted_)
+    {
+        first = static_cast<size_t>(std::lower_bound(idColumn.begin(), idColumn.end(), minId) - idColumn.begin());
+        last = static_cast<size_t>(std::upper_bound(idColumn.begin() + first, idColumn.end(), maxId) - idColumn.begin());
+    }
 
+    auto accept = [&](size_t slot) {
+        if (matches(slot) && (ids.empty() || std::binary_search(ids.begin(), ids.end(), idColumn[slot])))
+            out.push_back(&tasks_[slot]);
+    };
+    if (filter.status)
+    {
+        // Only visit positions with the right status
+        out.reserve(statusIndex_.Count(*filter.status));
+        statusIndex_.ForEach(*filter.status, first, last, accept);
+    }
+    else
+    {
+        for (size_t slot = first; slot < last; ++slot)
+        {
+            if (statusIndex_.IsLive(slot))
+                accept(slot);
+        }
+    }
     return out;
 }
 
+TaskView TaskList::GetByStatus(Task::Status s) const
+{
+    TaskFilter filter;
+    filter.status = s;
+    return Select(filter);
+}
+
+TaskView TaskList::FindByKeyWord(std::string_view word) const
+{
+    if (word.empty())
+        return {};
+    TaskFilter filter;
+    filter.keywords = word;
+    return Select(filter);
+}
+
+const Task* TaskList::FindById(int id) const
+{
+    auto slot = FindIndexById(id);
+    if (!slot)
+        return nullptr;
+    DecodeSlot(*slot);
+    return &tasks_[*slot];
+}
+
+std::vector<int> TaskList::QueryKeywords(std::string_view query) const
+{
+    // A single search, like a task-cli run, is cheaper as one pass over the
+    // descriptions than building the index. The index is built on the
+    // second search and the mutators keep it current afterwards.
+    DecodeAll();
+    {
+        std::unique_lock lock(lazyMutex_);
+        if (!index_ && searches_++ == 0)
+        {
+            lock.unlock();
+            KeywordIndex::Matcher matcher(query);
+            std::vector<int> ids;
+            for (size_t i = 0; i < tasks_.size(); ++i)
+            {
+                if (statusIndex_.IsLive(i) && matcher.Matches(tasks_[i].GetDescription()))
+                    ids.push_back(tasks_[i].GetId());
+            }
+            if (!idsSorted_)
+                std::sort(ids.begin(), ids.end());
+            return ids;
+        }
+        if (!index_)
+        {
+            index_.emplace();
+            for (size_t i = 0; i < tasks_.size(); ++i)
+            {
+                if (statusIndex_.IsLive(i))
+                    index_->Add(tasks_[i].GetId(), tasks_[i].GetDescription());
+            }
+        }
+    }
+
+    // Fragments the index cannot answer are scanned case-insensitively
+    auto scan = [this](std::string_view fragment) {
+        std::unique_lock lock(lazyMutex_);
+        if (!corpusValid_)
+        {
+            size_t bytes = 0;
+            for (auto const& task : tasks_)
+                bytes += task.GetDescription().size();
+            corpus_.Clear();
+            corpus_.Reserve(tasks_.size(), bytes);
+            // Dead slots stay as empty texts so positions match tasks_
+            for (size_t i = 0; i < tasks_.size(); ++i)
+                corpus_.Add(statusIndex_.IsLive(i) ? tasks_[i].GetDescription() : std::string_view{});
+            corpusValid_ = true;
+        }
+        lock.unlock();
+
+        std::vector<int> ids;
+        corpus_.FindAll(fragment, true, [&](size_t i) { ids.push_back(columns_.Ids()[i]); });
+        if (!idsSorted_)
+            std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    return index_->Query(query, scan);
+}
+
 std::filesystem::path TaskList::GetExecutablePath()
 {
     #ifdef _WIN32
@@ -198,145 +612,328 @@ std::filesystem::path TaskList::GetExecutablePath()
         char buf[PATH_MAX];
         ssize_t len = readlink("/proc/self/exe", buf, sizeof(buf)-1);
         buf[(len > 0 && len < (ssize_t)sizeof(buf)) ? len : 0] = '\0';
-        return std::filesystem:path{buf}.remove_filename();
+        return std::filesystem::path{buf}.remove_filename();
     #endif
 }
 
-std::vector<std::string> TaskList::SplitTasks(const std::string& json)
+bool TaskList::Flush()
 {
-    // Get indices for inner array of tasks
-    auto start = json.find('[');
-    auto end = json.rfind(']');
-    if (start == std::string::npos || end == std::string::npos || end <= start)
+    if (!journal_ && !dirty_)
+        return true;
+    auto lock = storeLock_.Acquire(FileLock::Mode::EXCLUSIVE);
+    if (journal_)
+        Sync();
+    else if (FileStamp::Of(g_taskListPath) != storeStamp_)
+        MergeTouched();
+
+    if (journal_ && journal_->SizeBytes() == 0 && !journalFailed_)
+        return true;
+    if (!snapshotValid_)
+    {
+        std::cerr << "Error: " << g_taskListPath 
+            << " could not be parsed, refusing to overwrite it\n";
+        return false;
+    }
+
+    CompactSlots();
+    DetachMapping();
+    auto tmp = WriteTempFile(tasks_, g_taskListPath, saveFormat_);
+    if (!tmp || !AtomicReplace(g_taskListPath, *tmp))
+        return false;
+    storeStamp_ = FileStamp::Of(g_taskListPath);
+    touched_.clear();
+    loadedNextId_ = nextId_;
+    dirty_ = false;
+    if (journal_ && journal_->Clear())
+        journalFailed_ = false;
+    return true;
+}
+
+bool TaskList::SyncJournal()
+{
+    return !journal_ || journal_->Sync();
+}
+
+FileLock::Guard TaskList::BeginWrite()
+{
+    // Without a journal the changes stay in memory, see MergeTouched()
+    if (!journal_)
         return {};
+    auto lock = storeLock_.Acquire(FileLock::Mode::EXCLUSIVE);
+    Sync();
+    return lock;
+}
+
+void TaskList::Load()
+{
+    // Borrowed descriptions point into the mapping and the arena
+    tasks_.clear();
+    records_.clear();
+    pendingRecords_ = 0;
+    mapping_.Close();
+    arena_.Release();
+    index_.reset();
+    idsSorted_ = true;
+    nextId_ = 1;
+
+    // A store that does not exist yet is an empty list, e.g. with a journal
+    // that was not compacted so far
+    storeStamp_ = FileStamp::Of(g_taskListPath);
+    bool loaded = !storeStamp_ || LoadFromFile(g_taskListPath);
+    // Never compact over a store that exists but could not be parsed
+    snapshotValid_ = loaded;
+    RebuildSlotIndexes();
+
+    if (options_.persistence == TaskListOptions::Persistence::JOURNAL)
+    {
+        auto journalPath = g_taskListPath;
+        journalPath += ".journal";
+        journal_.emplace(journalPath, options_.durable ? options_.groupCommit : 0);
+        journal_->Replay([this](const Journal::Record& record) { ApplyRecord(record); });
+    }
+    touched_.clear();
+    loadedNextId_ = nextId_;
+}
+
+void TaskList::Sync()
+{
+    // Changes that could not be journaled exist only here, keep them
+    if (journalFailed_)
+        return;
 
-    // Get inner array as string
-    std::string inner = json.substr(start + 1, end - start - 1);
+    auto apply = [this](const Journal::Record& record) {
+        ApplyRecord(record);
+        ++externalChanges_;
+    };
+    bool replaced = FileStamp::Of(g_taskListPath) != storeStamp_;
+    if (replaced || !journal_->CatchUp(apply))
+    {
+        Load();
+        ++externalChanges_;
+    }
+}
 
-    // iterate over string and count {}
-    std::vector<std::string> result;
-    int depth = 0;
-    size_t objStart = std::string::npos;
+void TaskList::MergeTouched()
+{
+    // Our current version of every touched task, nullopt for removed ones
+    std::sort(touched_.begin(), touched_.end());
+    touched_.erase(std::unique(touched_.begin(), touched_.end()), touched_.end());
+    std::vector<std::optional<Task>> ours;
+    ours.reserve(touched_.size());
+    for (auto [id, type] : touched_)
+    {
+        const Task* task = FindById(id);
+        ours.push_back(task ? std::optional<Task>(*task) : std::nullopt);
+    }
+    auto touches = std::move(touched_);
+    const int firstAdded = loadedNextId_;
 
-    for (size_t i = 0; i < inner.size(); ++i)
+    Load();
+    ++externalChanges_;
+    using Type = Journal::Record::Type;
+    for (size_t i = 0; i < touches.size();)
     {
-        char c = inner[i];
-        if (c == '{')
+        // All touches of one id, re-applied field by field
+        const int id = touches[i].first;
+        std::optional<Task>& task = ours[i];
+        bool updated = false;
+        bool marked = false;
+        for (; i < touches.size() && touches[i].first == id; ++i)
         {
-            if (depth == 0)
-            {
-                objStart = i;
-            }
-            ++depth;
+            updated |= touches[i].second == Type::UPDATE;
+            marked |= touches[i].second == Type::MARK;
         }
-        else if (c == '}')
+
+        auto slot = FindIndexById(id);
+        if (id >= firstAdded)
         {
-            --depth;
-            if (depth == 0 && objStart != std::string::npos)
+            // Added here; if another process took the id meanwhile, use the next free one
+            if (!task)
+                continue;
+            if (slot)
             {
-                // end of object reached
-                result.push_back(inner.substr(objStart, i - objStart + 1));
-                objStart = std::string::npos;
+                std::cerr << "Warning: task " << id << " was saved as " << nextId_ 
+                    << ", another process added a task with its id\n";
+                task = Task(nextId_, task->GetDescription(), task->GetStatus(), 
+                    task->GetCreatedAt(), task->GetUpdatedAt());
             }
+            touched_.emplace_back(task->GetId(), Type::ADD);
+            AppendSlot(std::move(*task));
+            continue;
+        }
+        if (!slot)
+        {
+            if (task)
+                std::cerr << "Warning: task " << id 
+                    << " was removed by another process, dropping its changes\n";
+            continue;
+        }
+        if (!task)
+        {
+            KillSlot(*slot);
+            touched_.emplace_back(id, Type::DELETE);
+            continue;
+        }
+
+        DecodeSlot(*slot);
+        Task& merged = tasks_[*slot];
+        auto updatedAt = task->GetUpdatedAt().value_or(task->GetCreatedAt());
+        if (updated)
+        {
+            merged.UpdateTask(task->GetDescription(), updatedAt);
+            columns_.Set(*slot, merged);
+            touched_.emplace_back(id, Type::UPDATE);
+        }
+        if (marked)
+        {
+            statusIndex_.Set(*slot, merged.GetStatus(), task->GetStatus());
+            merged.MarkTask(task->GetStatus(), updatedAt);
+            columns_.Set(*slot, merged);
+            touched_.emplace_back(id, Type::MARK);
         }
-        // ignore everything else
     }
+    corpusValid_ = false;
+}
 
-    return result;
+void TaskList::DetachMapping()
+{
+    if (!mapping_.IsOpen())
+        return;
+    DecodeAll();
+    const std::string_view mapped = mapping_.View();
+    for (auto& task : tasks_)
+    {
+        std::string_view desc = task.GetDescription();
+        if (!task.IsBorrowed() || desc.data() < mapped.data() 
+            || desc.data() >= mapped.data() + mapped.size())
+            continue;
+        task = Task::Borrowing(task.GetId(), arena_.Copy(desc), task.GetStatus(), 
+            task.GetCreatedAt(), task.GetUpdatedAt());
+    }
+    mapping_.Close();
 }
 
-std::string TaskList::ExtractJsonValue(const std::string& obj, const std::string& key)
+bool TaskList::SaveAs(const std::filesystem::path& path, TaskListOptions::Format format)
 {
-    // look for key
-    std::string pat = "\"" + key + "\"";
-    size_t p = obj.find(pat);
-    if (p == std::string::npos)
-        return {}; //not found
+    CompactSlots();
+    if (format == TaskListOptions::Format::AUTO)
+        format = saveFormat_;
 
-    // look for ':' after key
-    p = obj.find(':', p + pat.size());
-    if (p == std::string::npos)
-        return {};
+    DecodeAll();
+    auto tmp = WriteTempFile(tasks_, path, format);
+    return tmp && AtomicReplace(path, *tmp);
+}
 
-    // skip whitespace
-    ++p;
-    while (p < obj.size() && std::isspace((unsigned char)obj[p]))
-        ++p;
-    
-    // is value inside "" ?
-    if (p < obj.size() && obj[p] == '"')
+std::optional<std::filesystem::path> TaskList::WriteTempFile(const std::vector<Task>& tasks, 
+    const std::filesystem::path& target, TaskListOptions::Format format) const
+{
+    auto tmp = FileSync::UniqueTempPath(target);
+    if (!WriteVectorToFile(tasks, tmp, format))
     {
-        // string value
-        size_t start = ++p;
-        size_t end = obj.find('"', p);
-        return (end != std::string::npos)
-            ? obj.substr(start, end - start) // get inside of "..."
-            : std::string{};
+        std::error_code ec;
+        std::filesystem::remove(tmp, ec);
+        return std::nullopt;
     }
-    else 
-    {
-        // no string value
-        size_t start = p;
+    return tmp;
+}
 
-        // read till comma, curly bracked or whitespace
-        size_t end = obj.find(",}\n\r", start);
-        if (end == std::string::npos)
-            end = obj.size();
+bool TaskList::WriteVectorToFile(const std::vector<Task>& tasks, 
+    const std::filesystem::path& path, TaskListOptions::Format format) const
+{
+    if (format == TaskListOptions::Format::BINARY)
+        return BinarySnapshot::Write(tasks, path, options_.durable, nextId_);
 
-        // trim trailing spaces
-        while (end > start && std::isspace((unsigned char) obj[end-1]))
-            --end;
-        return obj.substr(start, end - start);
-    }
+    size_t threads = std::min(ThreadCount(options_.saveThreads), 
+        tasks.size() / MIN_SAVE_CHUNK_TASKS);
+    return WriteTasks(tasks, path, threads, options_.durable, nextId_);
 }
 
-void TaskList::WriteVectorToFile(std::vector<Task>& tasks)
+bool TaskList::WriteTasks(const std::vector<Task>& tasks, const std::filesystem::path& path, 
+    size_t threads, bool sync, int nextId)
 {
-    std::ofstream write_stream{g_taskListPathTmp, std::ios::trunc};
-    if (!write_stream)
+    // Flush in large blocks so a big store does not need to be held in
+    // memory twice
+    constexpr size_t FLUSH_BYTES = 1 << 20;
+
+    // Only a store whose newest tasks were removed needs the object; the
+    // others stay the plain array older versions read
+    int maxId = 0;
+    for (const auto& task : tasks)
+        maxId = std::max(maxId, task.GetId());
+    std::string open = "[\n";
+    std::string_view close = "]\n";
+    if (nextId > maxId + 1)
     {
-        std::cerr << g_taskListPathTmp << " Could not be opened for writing\n";
-        return ;
+        open = "{\"nextId\": " + std::to_string(nextId) + ", \"tasks\": [\n";
+        close = "]}\n";
     }
 
-    write_stream << "[\n";
-    for (size_t i = 0; i < tasks.size(); ++i)
+    OutputFile file;
+    if (!file.Open(path, OutputFile::Mode::TRUNCATE))
     {
-        tasks[i].ToJson(write_stream, 4);
-        if (i + 1 < tasks.size()) write_stream << ",";
-        write_stream << "\n";
+        std::cerr << path << " Could not be opened for writing\n";
+        return false;
     }
-    write_stream << "]\n";
-    write_stream.close();
-}
 
-// TODO:
-// This function will be deleted in the future.
-// The goal is to edit the json file in place and not to replace the whole file
-void TaskList::AtomicReplace(const std::filesystem::path& orig, const std::filesystem::path& tmp)
-{
-    namespace fs = std::filesystem;
-    std::error_code ec;
-
-    // Delete original file if exists
-    if (fs::exists(orig, ec))
+    threads = std::min(threads, tasks.size());
+    bool ok = true;
+    if (threads > 1)
     {
-        if (!fs::remove(orig, ec))
+        ok = WriteChunks(tasks, file, threads, open, close);
+    }
+    else
+    {
+        thread_local JsonWriter writer;
+        writer.Clear();
+        writer.Append(open);
+        for (size_t i = 0; i < tasks.size() && ok; ++i)
         {
-            std::cerr << "Error while deleting " << orig << ": " << ec.message()
-            << "\n";
-            return;
+            writer.AppendTask(tasks[i], 4);
+            writer.Append(i + 1 < tasks.size() ? ",\n" : "\n");
+            if (writer.Size() >= FLUSH_BYTES)
+            {
+                ok = file.Write(writer.View());
+                writer.Clear();
+            }
         }
+        writer.Append(close);
+        ok = ok && file.Write(writer.View());
+        writer.Clear();
     }
 
-    // Rename tmp file
-    fs::rename(tmp, orig, ec);
+    // fsync through the descriptor that wrote the data
+    if (ok && sync && !file.Sync())
+    {
+        std::cerr << "Error while syncing " << path << "\n";
+        file.Close();
+        return false;
+    }
+    if (!file.Close() || !ok)
+    {
+        std::cerr << "Error while writing " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool TaskList::AtomicReplace(const std::filesystem::path& orig, const std::filesystem::path& tmp) const
+{
+    // One rename replaces the store, readers see the old or the new one
+    std::error_code ec;
+    std::filesystem::rename(tmp, orig, ec);
     if (ec)
     {
         std::cerr << "Error while renaming " << tmp << ": " << ec.message()
         << "\n";
-        return;
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    if (options_.durable && !FileSync::Directory(orig.parent_path()))
+    {
+        std::cerr << "Error while syncing the directory of " << orig << "\n";
+        return false;
     }
+    return true;
 }
 
 std::optional<Task::Status> TaskList::ParseStatus(std::string_view sv)
@@ -360,108 +957,509 @@ std::optional<Task::Status> TaskList::ParseStatus(std::string_view sv)
     return std::nullopt;
 }
 
-std::chrono::system_clock::time_point TaskList::ParseDateTimeString(const std::string& dateStr)
+std::chrono::system_clock::time_point TaskList::ParseDateTimeString(std::string_view dateStr, 
+    std::chrono::system_clock::time_point now)
 {
     // Expected format: "2025-08-02 23:56:24"
-    std::tm tm = {};
-    std::istringstream ss(dateStr);
-    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-    
-    if (ss.fail()) {
-        // If parsing fails, return current time as fallback
-        return std::chrono::system_clock::now();
+    std::optional<std::chrono::system_clock::time_point> parsed = TimeCodec::Parse(dateStr);
+    if (!parsed)
+    {
+        // Lenient slow path for hand-edited stores, e.g. unpadded fields
+        std::tm tm = {};
+        std::istringstream ss{std::string(dateStr)};
+        ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+        
+        if (ss.fail()) {
+            // If parsing fails, return current time as fallback
+            return now;
+        }
+        
+        // Set timezone to local time
+        tm.tm_isdst = -1; // Let mktime determine DST
+        parsed = std::chrono::system_clock::from_time_t(std::mktime(&tm));
     }
     
-    // Set timezone to local time
-    tm.tm_isdst = -1; // Let mktime determine DST
-    
-    // Convert tm to time_t, then to time_point
-    std::time_t time = std::mktime(&tm);
-    
     // Check if the parsed time is in the future (more than 1 day ahead)
-    auto now = std::chrono::system_clock::now();
-    auto parsed_time = std::chrono::system_clock::from_time_t(time);
     auto one_day = std::chrono::hours(24);
     
-    if (parsed_time > now + one_day) {
+    if (*parsed > now + one_day) {
         // If the parsed time is more than 1 day in the future, 
         // it's likely a parsing error, so use current time
         return now;
     }
     
-    return parsed_time;
+    return *parsed;
 }
 
-bool TaskList::LoadFromFile(const std::filesystem::path& jsonPath)
+std::optional<Task> TaskList::MakeTask(const JsonReader& reader, const JsonReader::TaskFields& fields, 
+    std::chrono::system_clock::time_point now, bool borrowDescriptions, StringArena* arena,
+    std::ostream& err)
 {
-    auto exeDir = GetExecutablePath();
-    g_taskListPath = exeDir / jsonPath;
-    g_taskListPathTmp = exeDir / "../task-tracker.json.tmp";
+    if ((fields.present & JsonReader::TaskFields::HAS_ALL) 
+        != JsonReader::TaskFields::HAS_ALL)
+    {
+        err << "Error: Missing field in task object at offset " 
+            << reader.Offset() << "\n";
+        return std::nullopt;
+    }
 
-    // Open JSON file
-    // Create reading stream to json file
-    std::ifstream read_stream{g_taskListPath};
-    if (!read_stream)
+    int id = 0;
+    auto [ptr, ec] = std::from_chars(
+        fields.id.data(), fields.id.data() + fields.id.size(), id);
+    if (ec != std::errc{} || ptr != fields.id.data() + fields.id.size())
     {
-        std::cerr << g_taskListPath << " Could not be opened for reading\n";
+        err << "Error: Invalid id value in JSON\n";
+        return std::nullopt;
+    }
+
+    auto status = ParseStatus(fields.status);
+    if (!status)
+    {
+        err << "Error: Invalid status value in JSON\n";
+        return std::nullopt;
+    }
+
+    // Parse date strings to time_point objects
+    auto createdAtTp = ParseDateTimeString(fields.createdAt, now);
+    std::optional<std::chrono::system_clock::time_point> updatedAtTp;
+    if (fields.updatedAt != "null") {
+        updatedAtTp = ParseDateTimeString(fields.updatedAt, now);
+    }
+
+    // Escaped descriptions live in the reader's scratch buffer
+    if (borrowDescriptions && reader.IsInput(fields.description))
+        return Task::Borrowing(id, fields.description, *status, createdAtTp, updatedAtTp);
+    if (arena)
+        return Task::Borrowing(id, arena->Copy(fields.description), *status, createdAtTp, updatedAtTp);
+    return Task(id, fields.description, *status, createdAtTp, updatedAtTp);
+}
+
+bool TaskList::ParseTasks(std::string_view json, std::vector<Task>& out, 
+    bool borrowDescriptions, StringArena* arena)
+{
+    JsonReader reader{json};
+    if (!reader.BeginArray())
+    {
+        std::cerr << "Error: " << reader.Error() << "\n";
         return false;
     }
 
-    // Read JSON file
-    // Stream whole file into as one string
-    std::string wholeJsonFile;
+    // Decode every object straight into a Task, no per-object strings
+    const auto now = std::chrono::system_clock::now();
+    JsonReader::TaskFields fields;
+    while (reader.NextTask(fields))
     {
-        std::ostringstream oss;
-        oss << read_stream.rdbuf();
-        wholeJsonFile = oss.str();
+        auto task = MakeTask(reader, fields, now, borrowDescriptions, arena);
+        if (!task)
+            return false;
+        out.push_back(std::move(*task));
     }
-    if (wholeJsonFile.empty() || wholeJsonFile == "")
+
+    if (reader.Failed())
     {
-        std::cerr << "Error: jsonfilestring is empty\n";
+        std::cerr << "Error: Invalid JSON at offset " << reader.Offset() 
+            << ": " << reader.Error() << "\n";
         return false;
     }
+    return true;
+}
+
+bool TaskList::ParseTasksParallel(std::string_view json, std::vector<Task>& out, size_t chunks,
+    bool borrowDescriptions, StringArena* arena)
+{
+    // Chunk k decodes the objects starting in [begin, end), where end is
+    // where chunk k + 1 begins. The chunk before checks that its last
+    // object is followed by exactly that one, which proves the split.
+    struct Chunk
+    {
+        size_t begin = 0;
+        size_t end = 0;
+        // Start of the first object at or after end, json.size() after ']'
+        size_t next = 0;
+        bool ok = false;
+        std::vector<Task> tasks;
+    };
+    std::vector<Chunk> parts(1);
+    for (size_t k = 1; k < chunks; ++k)
+    {
+        size_t begin = NextObjectStart(json, json.size() / chunks * k);
+        if (begin >= json.size())
+            break;
+        if (begin > parts.back().begin)
+            parts.emplace_back().begin = begin;
+    }
+    for (size_t k = 0; k < parts.size(); ++k)
+        parts[k].end = k + 1 < parts.size() ? parts[k + 1].begin : json.size();
+    if (parts.size() == 1)
+        return ParseTasks(json, out, borrowDescriptions, arena);
+
+    // The arena is not thread-safe: chunks own escaped descriptions and
+    // they are moved into it after the merge
+    const auto now = std::chrono::system_clock::now();
+    auto parse = [&](Chunk& chunk)
+    {
+        JsonReader reader{json};
+        if (chunk.begin == 0)
+        {
+            if (!reader.BeginArray())
+                return;
+        }
+        else
+        {
+            reader.Seek(chunk.begin);
+        }
+
+        // Errors are reported by the serial fallback, a chunk may have
+        // started inside a description
+        std::ostringstream errors;
+        JsonReader::TaskFields fields;
+        chunk.tasks.reserve((chunk.end - chunk.begin) / 128);
+        while (reader.NextTask(fields))
+        {
+            const size_t at = static_cast<size_t>(fields.object.data() - json.data());
+            if (at >= chunk.end)
+            {
+                chunk.next = at;
+                chunk.ok = true;
+                return;
+            }
+            auto task = MakeTask(reader, fields, now, borrowDescriptions, nullptr, errors);
+            if (!task)
+                return;
+            chunk.tasks.push_back(std::move(*task));
+        }
+        chunk.next = json.size();
+        chunk.ok = !reader.Failed();
+    };
+
+    RunChunks(parts.size(), [&](size_t k) { parse(parts[k]); });
+
+    size_t total = 0;
+    for (size_t k = 0; k < parts.size(); ++k)
+    {
+        const size_t expected = k + 1 < parts.size() ? parts[k + 1].begin : json.size();
+        if (!parts[k].ok || parts[k].next != expected)
+            return ParseTasks(json, out, borrowDescriptions, arena);
+        total += parts[k].tasks.size();
+    }
+
+    out.reserve(out.size() + total);
+    for (auto& part : parts)
+    {
+        for (auto& task : part.tasks)
+        {
+            if (arena && !task.IsBorrowed())
+            {
+                task = Task::Borrowing(task.GetId(), arena->Copy(task.GetDescription()), 
+                    task.GetStatus(), task.GetCreatedAt(), task.GetUpdatedAt());
+            }
+            out.push_back(std::move(task));
+        }
+    }
+    return true;
+}
 
-    // Get every task object as a string
-    auto tasksJson = SplitTasks(wholeJsonFile);
-    if (tasksJson.empty())
+bool TaskList::ScanTasks(std::string_view json, std::vector<Task>& out, 
+    std::vector<std::string_view>& records)
+{
+    JsonReader reader{json};
+    if (!reader.BeginArray())
     {
-        std::cerr << "Error: tasksJson is empty\n";
+        std::cerr << "Error: " << reader.Error() << "\n";
         return false;
     }
-    // Save data in tasks_
-    // Convert task object strings to Task object
-    for (auto const& s : tasksJson)
-    {
-        // Get string inside {}
-        auto start = s.find('{');
-        auto end = s.find('}');
-        std::string inner = s.substr(start, end - start -1);
-
-        // Get values
-        // TODO: needs checking
-        int id = std::stoi(ExtractJsonValue(inner, "id"));
-        std::string desc = ExtractJsonValue(inner, "description");
-        auto status = 
-            ParseStatus(ExtractJsonValue(inner, "status"));
-        if (!status)
-        {
-            std::cerr << "Error: Invalid status value in JSON\n";
+
+    // Only id and status are converted, timestamps and descriptions wait
+    // for DecodeSlot()
+    JsonReader::TaskFields fields;
+    while (reader.NextTask(fields))
+    {
+        if ((fields.present & JsonReader::TaskFields::HAS_ALL) 
+            != JsonReader::TaskFields::HAS_ALL)
+        {
+            std::cerr << "Error: Missing field in task object at offset " 
+                << reader.Offset() << "\n";
             return false;
         }
-        std::string createdAt = ExtractJsonValue(inner, "createdAt");
-        std::string updatedAt = ExtractJsonValue(inner, "updatedAt");
-        
-        // Parse date strings to time_point objects
-        auto createdAtTp = ParseDateTimeString(createdAt);
-        std::optional<std::chrono::system_clock::time_point> updatedAtTp;
-        if (updatedAt != "null") {
-            updatedAtTp = ParseDateTimeString(updatedAt);
+
+        int id = 0;
+        auto [ptr, ec] = std::from_chars(
+            fields.id.data(), fields.id.data() + fields.id.size(), id);
+        auto status = ParseStatus(fields.status);
+        if (ec != std::errc{} || ptr != fields.id.data() + fields.id.size() || !status)
+        {
+            std::cerr << "Error: Invalid id or status value in JSON\n";
+            return false;
         }
-        
-        tasks_.push_back(
-            Task(id, desc, *status, 
-                createdAtTp, updatedAtTp));
+        out.emplace_back(id, std::string_view{}, *status, 
+            std::chrono::system_clock::time_point{}, std::nullopt);
+        records.push_back(fields.object);
     }
-    if(read_stream.is_open()) read_stream.close();
+
+    if (reader.Failed())
+    {
+        std::cerr << "Error: Invalid JSON at offset " << reader.Offset() 
+            << ": " << reader.Error() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool TaskList::LoadFromFile(const std::filesystem::path& jsonPath)
+{
+    // Map the store (JSON or binary), descriptions are views into the mapping
+    if (!mapping_.Open(jsonPath))
+    {
+        std::cerr << jsonPath << " Could not be opened for reading\n";
+        return false;
+    }
+    if (mapping_.View().empty())
+    {
+        std::cerr << "Error: jsonfilestring is empty\n";
+        return false;
+    }
+
+    // Save data in tasks_
+    std::vector<Task> loaded;
+    const bool binary = BinarySnapshot::IsBinary(mapping_.View());
+    if (binary)
+    {
+        if (!BinarySnapshot::Read(mapping_.View(), loaded))
+            return false;
+        if (options_.format == TaskListOptions::Format::AUTO)
+            saveFormat_ = TaskListOptions::Format::BINARY;
+    }
+    else if (options_.lazy)
+    {
+        std::vector<std::string_view> records;
+        if (!ScanTasks(mapping_.View(), loaded, records))
+            return false;
+        pendingRecords_ = records.size();
+        records_ = std::move(records);
+    }
+    else
+    {
+        size_t threads = std::min(ThreadCount(options_.loadThreads), 
+            mapping_.View().size() / MIN_LOAD_CHUNK_BYTES);
+        bool parsed = threads > 1 
+            ? ParseTasksParallel(mapping_.View(), loaded, threads, true, &arena_)
+            : ParseTasks(mapping_.View(), loaded, true, &arena_);
+        if (!parsed)
+            return false;
+    }
+    tasks_ = std::move(loaded);
+    // A store in another format than the requested one is converted on save
+    if (binary != (saveFormat_ == TaskListOptions::Format::BINARY))
+        dirty_ = true;
+
+    // Ids of stores written by us ascend, which allows binary search by id
+    for (size_t i = 0; i < tasks_.size(); ++i)
+    {
+        if (i > 0 && tasks_[i].GetId() <= tasks_[i - 1].GetId())
+            idsSorted_ = false;
+        nextId_ = std::max(nextId_, tasks_[i].GetId() + 1);
+    }
+    // Removed tasks may have had higher ids than any left
+    nextId_ = std::max(nextId_, StoredNextId(mapping_.View()));
     return true;
-}
\ No newline at end of file
+}
+
+void TaskList::DecodeSlot(size_t slot) const
+{
+    if (!options_.lazy)
+        return;
+    std::lock_guard lock(lazyMutex_);
+    DecodeRecord(slot);
+}
+
+void TaskList::DecodeAll() const
+{
+    if (!options_.lazy)
+        return;
+    std::lock_guard lock(lazyMutex_);
+    for (size_t slot = 0; slot < records_.size() && pendingRecords_ > 0; ++slot)
+        DecodeRecord(slot);
+}
+
+void TaskList::DecodeRecord(size_t slot) const
+{
+    if (records_.empty() || records_[slot].empty())
+        return;
+
+    // Decoding only fills in what the slot already stands for
+    auto& self = const_cast<TaskList&>(*this);
+    JsonReader reader{records_[slot]};
+    JsonReader::TaskFields fields;
+    // ScanTasks checked id and status, the timestamps fall back to now
+    if (reader.ReadTask(fields))
+    {
+        if (auto task = MakeTask(reader, fields, std::chrono::system_clock::now(), true, &self.arena_))
+        {
+            self.tasks_[slot] = std::move(*task);
+            self.columns_.Set(slot, tasks_[slot]);
+        }
+    }
+    self.records_[slot] = {};
+    if (--self.pendingRecords_ == 0)
+        self.records_.clear();
+}
+
+std::optional<size_t> TaskList::FindIndexById(int id) const
+{
+    return idIndex_.Find(id);
+}
+
+void TaskList::RebuildSlotIndexes()
+{
+    statusIndex_.Assign(tasks_);
+    columns_.Assign(tasks_);
+    idIndex_.Clear();
+    idIndex_.Reserve(tasks_.size());
+    for (size_t i = 0; i < tasks_.size(); ++i)
+    {
+        // Duplicate ids in a hand-edited store: the first one wins
+        idIndex_.Insert(tasks_[i].GetId(), i);
+    }
+    deadSlots_ = 0;
+    corpusValid_ = false;
+}
+
+void TaskList::AppendSlot(Task task)
+{
+    if (!tasks_.empty() && tasks_.back().GetId() >= task.GetId())
+        idsSorted_ = false;
+    nextId_ = std::max(nextId_, task.GetId() + 1);
+
+    tasks_.push_back(std::move(task));
+    if (!records_.empty())
+        records_.emplace_back();
+    const Task& added = tasks_.back();
+    statusIndex_.PushBack(added.GetStatus());
+    columns_.PushBack(added);
+    idIndex_.Insert(added.GetId(), tasks_.size() - 1);
+    if (index_)
+        index_->Add(added.GetId(), added.GetDescription());
+    corpusValid_ = false;
+}
+
+void TaskList::KillSlot(size_t slot)
+{
+    // Dead slots are never read, no need to decode them
+    if (!records_.empty() && !records_[slot].empty())
+    {
+        records_[slot] = {};
+        if (--pendingRecords_ == 0)
+            records_.clear();
+    }
+    const Task& task = tasks_[slot];
+    if (index_)
+        index_->Remove(task.GetId(), task.GetDescription());
+    statusIndex_.Remove(slot, task.GetStatus());
+    idIndex_.Erase(task.GetId());
+    ++deadSlots_;
+    corpusValid_ = false;
+}
+
+void TaskList::CompactSlots()
+{
+    if (deadSlots_ == 0)
+        return;
+
+    size_t out = 0;
+    for (size_t i = 0; i < tasks_.size(); ++i)
+    {
+        if (!statusIndex_.IsLive(i))
+            continue;
+        if (out != i)
+        {
+            tasks_[out] = std::move(tasks_[i]);
+            if (!records_.empty())
+                records_[out] = records_[i];
+        }
+        ++out;
+    }
+    tasks_.erase(tasks_.begin() + static_cast<std::ptrdiff_t>(out), tasks_.end());
+    if (!records_.empty())
+        records_.resize(out);
+    RebuildSlotIndexes();
+}
+
+void TaskList::ApplyRecord(const Journal::Record& record)
+{
+    // Records carry absolute values, applying one twice is a no-op
+    auto index = FindIndexById(record.id);
+    switch (record.type)
+    {
+        case Journal::Record::Type::ADD:
+        {
+            Task task(record.id, record.description, record.status, 
+                record.timestamp, std::nullopt);
+            if (!index)
+            {
+                AppendSlot(std::move(task));
+                break;
+            }
+
+            // Replayed over a store that already has the task
+            DecodeSlot(*index);
+            Task& existing = tasks_[*index];
+            if (index_)
+                index_->Remove(existing.GetId(), existing.GetDescription());
+            statusIndex_.Set(*index, existing.GetStatus(), task.GetStatus());
+            existing = std::move(task);
+            columns_.Set(*index, existing);
+            if (index_)
+                index_->Add(existing.GetId(), existing.GetDescription());
+            corpusValid_ = false;
+            break;
+        }
+        case Journal::Record::Type::UPDATE:
+            if (index)
+            {
+                DecodeSlot(*index);
+                Task& task = tasks_[*index];
+                if (index_)
+                    index_->Remove(task.GetId(), task.GetDescription());
+                task.UpdateTask(record.description, record.timestamp);
+                columns_.Set(*index, task);
+                if (index_)
+                    index_->Add(task.GetId(), task.GetDescription());
+                corpusValid_ = false;
+            }
+            break;
+        case Journal::Record::Type::MARK:
+            if (index)
+            {
+                DecodeSlot(*index);
+                statusIndex_.Set(*index, tasks_[*index].GetStatus(), record.status);
+                tasks_[*index].MarkTask(record.status, record.timestamp);
+                columns_.Set(*index, tasks_[*index]);
+            }
+            break;
+        case Journal::Record::Type::DELETE:
+            if (index)
+                KillSlot(*index);
+            break;
+    }
+}
+
+void TaskList::LogRecord(const Journal::Record& record)
+{
+    dirty_ = true;
+    if (!journal_)
+    {
+        touched_.emplace_back(record.id, record.type);
+        return;
+    }
+    if (journalFailed_)
+        return;
+
+    // The change is already applied in memory; if it cannot be journaled
+    // the whole store is rewritten on destruction instead
+    if (!journal_->Append(record))
+    {
+        std::cerr << "Error: falling back to a full rewrite of " 
+            << g_taskListPath << "\n";
+        journalFailed_ = true;
+    }
+}
@@ -1,49 +1,275 @@
 #pragma once
 #include "Task.h"
+#include "FileIO.h"
+#include "IdIndex.h"
+#include "Journal.h"
+#include "JsonReader.h"
+#include "KeywordIndex.h"
+#include "StatusIndex.h"
+#include "StringArena.h"
+#include "SubstringScan.h"
+#include "TaskColumns.h"
+#include "TaskPrinter.h"
+#include "TaskView.h"
+#include <iostream>
+#include <limits>
+#include <mutex>
 #include <vector>
 #include <optional>
 #include <string_view>
 #include <filesystem>
 #include <chrono>
 
+struct TaskListOptions
+{
+    enum class Persistence
+    {
+        // Rewrite the whole store when the TaskList is destroyed
+        REWRITE,
+        // Append every mutation to <store>.journal and fold the journal
+        // into the store only once it outgrows journalCompactBytes
+        JOURNAL
+    };
+    enum class Format
+    {
+        // Keep the format of the loaded store, new stores are JSON
+        AUTO,
+        JSON,
+        // Fixed-width records plus a description heap, see BinarySnapshot.h
+        BINARY
+    };
+    Persistence persistence = Persistence::REWRITE;
+    Format format = Format::AUTO;
+    size_t journalCompactBytes = 1 << 20;
+    // fsync saves before they replace the store, and the journal
+    bool durable = true;
+    // Journal records per fsync when durable: 1 makes every mutation durable
+    // before it returns, larger groups amortize the fsync over a batch or a
+    // server's clients. The price: a crash loses the mutations of the
+    // incomplete group although they were reported done. Pending records
+    // are synced on destruction and by SyncJournal().
+    size_t groupCommit = 1;
+    // Loading a JSON store only scans it for ids and statuses; the other
+    // fields of a task are decoded when it is first read or changed. Pays
+    // off for commands that touch a few tasks of a large store.
+    bool lazy = false;
+    // Threads that parse a large JSON store eagerly, 0 for one per core.
+    // Stores below a few MiB per thread are parsed on fewer.
+    unsigned loadThreads = 0;
+    // Threads that format a large JSON store on save, 0 for one per core
+    unsigned saveThreads = 0;
+};
+
+// Conditions for TaskList::Select, all of them have to hold
+struct TaskFilter
+{
+    std::optional<Task::Status> status;
+    // Inclusive id range
+    int minId = std::numeric_limits<int>::min();
+    int maxId = std::numeric_limits<int>::max();
+    // Query in KeywordIndex::Query syntax, empty matches everything
+    std::string_view keywords;
+    // Inclusive time ranges. A bounded updatedAt range only matches tasks
+    // that were updated at all.
+    std::chrono::system_clock::time_point createdFrom = std::chrono::system_clock::time_point::min();
+    std::chrono::system_clock::time_point createdTo = std::chrono::system_clock::time_point::max();
+    std::chrono::system_clock::time_point updatedFrom = std::chrono::system_clock::time_point::min();
+    std::chrono::system_clock::time_point updatedTo = std::chrono::system_clock::time_point::max();
+};
+
+// Order and window of a TaskList::Select result
+struct TaskOrder
+{
+    enum class Key
+    {
+        ID, CREATED, UPDATED
+    };
+    Key key = Key::ID;
+    // Highest id or newest first; never-updated tasks come last then
+    bool descending = false;
+    size_t offset = 0;
+    size_t limit = std::numeric_limits<size_t>::max();
+};
+
+// Const members may run concurrently with each other, but not with a
+// mutator; callers sharing a list between threads need a reader/writer lock.
+//
+// Processes sharing a store coordinate through an advisory lock on
+// <store>.lock. Loading takes it shared. With a journal, every mutation
+// takes it exclusively, first applies what other processes journaled and
+// then appends its own record. Without one, changes stay in memory; if
+// another process replaced the store in the meantime, saving re-reads it
+// and re-applies the changed fields of the tasks touched here.
 class TaskList
 {
 public:
-    TaskList(const std::filesystem::path& jsonPath = "task-tracker.json");
+    TaskList(const std::filesystem::path& jsonPath = "task-tracker.json", 
+        TaskListOptions options = {});
     ~TaskList();
 
-    // CRUD
-    bool AddTask(std::string_view desc);
-    bool UpdateTask(size_t index, std::string desc);
-    bool RemoveTask(size_t index);
-    bool MarkTask(size_t index, Task::Status);
-    bool ListTasks(std::string s);
+    // CRUD, tasks are addressed by their id. Why a mutation failed goes
+    // to err.
+    bool AddTask(std::string_view desc, std::ostream& err = std::cerr);
+    bool UpdateTask(int id, std::string desc, std::ostream& err = std::cerr);
+    bool RemoveTask(int id, std::ostream& err = std::cerr);
+    bool MarkTask(int id, Task::Status, std::ostream& err = std::cerr);
+    bool ListTasks(std::string_view s, std::ostream& out = std::cout) const;
+    // Prints one page of the tasks with status s (all for an empty s)
+    bool ListTasks(std::string_view s, const TaskOrder& order, std::ostream& out = std::cout, 
+        TaskPrinter::Format format = TaskPrinter::Format::TEXT) const;
 
     // Helper
-    void PrintAllTasks() const;
+    void PrintAllTasks(std::ostream& out = std::cout) const;
+    // Writes the store now instead of on destruction; with a journal, folds
+    // it into the store and clears it
+    bool Flush();
+    // fsyncs the journal records of an incomplete commit group
+    bool SyncJournal();
+    // Import/export: writes all tasks to another store in the given format
+    bool SaveAs(const std::filesystem::path& path, TaskListOptions::Format format);
     // Size
-    size_t Size() const noexcept { return tasks_.size(); }
+    size_t Size() const noexcept { return tasks_.size() - deadSlots_; }
+    // Id the next AddTask assigns
+    int NextId() const noexcept { return nextId_; }
+    // Changed since the store was loaded or last written by this list
+    bool IsDirty() const noexcept { return dirty_; }
+    // Grows whenever changes of other processes were picked up
+    size_t ExternalChanges() const noexcept { return externalChanges_; }
+    size_t CountByStatus(Task::Status s) const noexcept { return statusIndex_.Count(s); }
     
     // Filter
-    std::vector<Task> GetByStatus(Task::Status s) const;
-    std::vector<Task> FindByKeyWord(std::string_view word) const;
+    // Views point into the list and are invalidated by the next modification
+    TaskView Select(const TaskFilter& filter) const;
+    // Selects the window before sorting it: O(n + k log k) for k = offset + limit
+    TaskView Select(const TaskFilter& filter, const TaskOrder& order) const;
+    TaskView GetByStatus(Task::Status s) const;
+    // Keyword search, see KeywordIndex::Query for the query syntax
+    TaskView FindByKeyWord(std::string_view word) const;
+    // nullptr if there is no such task; invalidated like views
+    const Task* FindById(int id) const;
+
+    // Parsing
+    // With borrowDescriptions, unescaped descriptions are views into json.
+    // With an arena, the other descriptions are copied into it and borrowed.
+    static bool ParseTasks(std::string_view json, std::vector<Task>& out, 
+        bool borrowDescriptions = false, StringArena* arena = nullptr);
+    // ParseTasks on up to chunks threads, each decoding a range of objects;
+    // same result and errors. Falls back to one thread if the chunks do not
+    // line up with object boundaries.
+    static bool ParseTasksParallel(std::string_view json, std::vector<Task>& out, size_t chunks,
+        bool borrowDescriptions = false, StringArena* arena = nullptr);
+    // Writes tasks as a JSON store; descriptions are escaped. With several
+    // threads, each formats a range of tasks and writes it at its offset;
+    // the whole store is held in memory once then. With sync, the file is
+    // fsynced before it is closed. A nextId above the tasks' ids is kept in
+    // a store object around the array, see JsonReader.
+    static bool WriteTasks(const std::vector<Task>& tasks, const std::filesystem::path& path, 
+        size_t threads = 1, bool sync = false, int nextId = 0);
 
 private:
+    // One task from the fields of a store object, nullopt with a message
+    // on err if a field is missing or invalid
+    static std::optional<Task> MakeTask(const JsonReader& reader, const JsonReader::TaskFields& fields, 
+        std::chrono::system_clock::time_point now, bool borrowDescriptions, StringArena* arena,
+        std::ostream& err = std::cerr);
+    // Lazy counterpart of ParseTasks: tasks with only id and status, plus
+    // the raw object of every task
+    static bool ScanTasks(std::string_view json, std::vector<Task>& out, 
+        std::vector<std::string_view>& records);
+
     // Modify
-    std::vector<std::string> SplitTasks(const std::string& json);
-    std::string ExtractJsonValue(const std::string& obj, const std::string& key);
-    std::optional<Task::Status> ParseStatus(std::string_view sv);
-    std::chrono::system_clock::time_point ParseDateTimeString(const std::string& dateStr);
+    static std::optional<Task::Status> ParseStatus(std::string_view sv);
+    static std::chrono::system_clock::time_point ParseDateTimeString(std::string_view dateStr, 
+        std::chrono::system_clock::time_point now);
     
     // File management
     std::filesystem::path GetExecutablePath();
-    void AtomicReplace(const std::filesystem::path& orig, const std::filesystem::path& tmp);
-    void WriteVectorToFile(std::vector<Task>& tasks);
+    // Writes tasks to a fresh temp file next to target, synced if durable
+    std::optional<std::filesystem::path> WriteTempFile(const std::vector<Task>& tasks, 
+        const std::filesystem::path& target, TaskListOptions::Format format) const;
+    bool AtomicReplace(const std::filesystem::path& orig, const std::filesystem::path& tmp) const;
+    // Moves descriptions borrowed from the mapping into the arena and unmaps
+    // the store, so it can be replaced
+    void DetachMapping();
+    bool WriteVectorToFile(const std::vector<Task>& tasks, const std::filesystem::path& path, 
+        TaskListOptions::Format format) const;
     bool LoadFromFile(const std::filesystem::path& jsonPath);
+    // (Re)loads store and journal, the caller holds the store lock
+    void Load();
+
+    // Cross-process, see the class comment
+    // Takes the store lock for a mutation and catches up with the journal
+    FileLock::Guard BeginWrite();
+    // Applies changes other processes made since this list last synced
+    void Sync();
+    // Reloads the replaced store and re-applies the changes in touched_
+    void MergeTouched();
+
+    // Journal
+    void ApplyRecord(const Journal::Record& record);
+    void LogRecord(const Journal::Record& record);
+    std::optional<size_t> FindIndexById(int id) const;
+
+    // Lazy loading: fills in a slot that still holds only id and status.
+    // The list does not change for its users, so const members call these
+    // before they read a task.
+    void DecodeSlot(size_t slot) const;
+    void DecodeAll() const;
+    // The caller holds lazyMutex_
+    void DecodeRecord(size_t slot) const;
+
+    // Slots: removed tasks stay in tasks_ as dead slots until compaction,
+    // so removal never shifts the tasks behind it
+    void RebuildSlotIndexes();
+    void AppendSlot(Task task);
+    void KillSlot(size_t slot);
+    void CompactSlots();
+    // Tasks matching filter in slot order
+    std::vector<const Task*> Match(const TaskFilter& filter) const;
+    // Sorted ids of the tasks matching a keyword query
+    std::vector<int> QueryKeywords(std::string_view query) const;
     //bool SaveToFile(std::string const& filename) const;
 
 private:
+    TaskListOptions options_;
+    MappedFile mapping_;
+    // Loaded descriptions that are not views into the mapping; updated ones
+    // are owned by their task
+    StringArena arena_;
     std::vector<Task> tasks_;
+    // With lazy loading, the store object of every slot not decoded yet;
+    // empty once all are
+    std::vector<std::string_view> records_;
+    size_t pendingRecords_ = 0;
+    std::optional<Journal> journal_;
+    StatusIndex statusIndex_;
+    // Ids and timestamps by slot, what Select scans
+    TaskColumns columns_;
+    IdIndex idIndex_;
+    size_t deadSlots_ = 0;
+    // Guards the lazy builds of index_ and corpus_ for concurrent readers
+    mutable std::mutex lazyMutex_;
+    mutable std::optional<KeywordIndex> index_;
+    mutable size_t searches_ = 0;
+    // Descriptions in task order for substring scans, rebuilt on demand
+    mutable SubstringScan::Corpus corpus_;
+    mutable bool corpusValid_ = false;
     std::filesystem::path g_taskListPath;
-    std::filesystem::path g_taskListPathTmp;
+    TaskListOptions::Format saveFormat_ = TaskListOptions::Format::JSON;
+    int nextId_ = 1;
+    bool idsSorted_ = true;
+    bool snapshotValid_ = true;
+    bool journalFailed_ = false;
+
+    FileLock storeLock_;
+    // Store as this list last read or wrote it, nullopt if it did not exist
+    std::optional<FileStamp> storeStamp_;
+    // Without a journal: changes since then by task id, and the first id
+    // added here
+    std::vector<std::pair<int, Journal::Record::Type>> touched_;
+    int loadedNextId_ = 1;
+    // Set by every mutation and by a store to convert to another format;
+    // a clean list never writes the store or compacts the journal
+    bool dirty_ = false;
+    size_t externalChanges_ = 0;
 };
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "TaskPrinter.h"
+
+#include <charconv>
+
+namespace
+{
+    constexpr std::string_view TABLE_HEADER =
+        "    id  status       createdAt            updatedAt            description\n";
+    constexpr size_t ID_WIDTH = 6;
+    constexpr size_t STATUS_WIDTH = 11;
+
+    struct ByteSet
+    {
+        bool value[256];
+    };
+
+    // Bytes TSV escapes
+    constexpr auto TSV_SPECIAL = [] {
+        ByteSet table{};
+        table.value['\t'] = table.value['\n'] = table.value['\r'] = table.value['\\'] = true;
+        return table;
+    }();
+
+    // Bytes TEXT and TABLE escape: control characters, which would break
+    // lines and columns or drive the terminal. Backslashes stay as they are.
+    constexpr auto DISPLAY_SPECIAL = [] {
+        ByteSet table{};
+        for (int c = 0; c < 0x20; ++c)
+            table.value[c] = true;
+        table.value[0x7f] = true;
+        return table;
+    }();
+
+    void AppendEscaped(JsonWriter& buffer, std::string_view text, const ByteSet& special)
+    {
+        static constexpr char HEX[] = "0123456789abcdef";
+        const char* p = text.data();
+        const char* const end = p + text.size();
+        while (true)
+        {
+            // copy runs that need no escaping in one go
+            const char* run = p;
+            while (run < end && !special.value[static_cast<unsigned char>(*run)])
+                ++run;
+            buffer.Append({p, static_cast<size_t>(run - p)});
+            if (run == end)
+                break;
+            const auto c = static_cast<unsigned char>(*run);
+            if (c == '\t')
+                buffer.Append("\\t");
+            else if (c == '\n')
+                buffer.Append("\\n");
+            else if (c == '\r')
+                buffer.Append("\\r");
+            else if (c == '\\')
+                buffer.Append("\\\\");
+            else
+            {
+                const char hex[] = {'\\', 'x', HEX[c >> 4], HEX[c & 0xf]};
+                buffer.Append({hex, sizeof(hex)});
+            }
+            p = run + 1;
+        }
+    }
+
+    std::string_view Padding(size_t used, size_t width) noexcept
+    {
+        constexpr std::string_view spaces = "                ";
+        return used < width ? spaces.substr(0, width - used) : std::string_view{};
+    }
+}
+
+TaskPrinter::TaskPrinter(std::ostream& out, Format format)
+    : m_out(out), m_format(format)
+{
+
+}
+
+TaskPrinter::~TaskPrinter()
+{
+    Flush();
+}
+
+std::optional<TaskPrinter::Format> TaskPrinter::ParseFormat(std::string_view name) noexcept
+{
+    if (name == "text")
+        return Format::TEXT;
+    if (name == "table")
+        return Format::TABLE;
+    if (name == "jsonl")
+        return Format::JSONL;
+    if (name == "tsv")
+        return Format::TSV;
+    return std::nullopt;
+}
+
+std::string_view TaskPrinter::Timestamp(std::chrono::system_clock::time_point tp, CachedTimestamp& cache)
+{
+    auto second = std::chrono::floor<std::chrono::seconds>(tp);
+    if (second != cache.second)
+    {
+        TimeCodec::Format(tp, cache.text);
+        cache.second = second;
+    }
+    return {cache.text, sizeof(cache.text)};
+}
+
+void TaskPrinter::AppendTsvEscaped(std::string_view text)
+{
+    AppendEscaped(m_buffer, text, TSV_SPECIAL);
+}
+
+void TaskPrinter::AppendDisplayEscaped(std::string_view text)
+{
+    AppendEscaped(m_buffer, text, DISPLAY_SPECIAL);
+}
+
+void TaskPrinter::Print(const Task& task)
+{
+    char idBuf[16];
+    const std::string_view id{idBuf, static_cast<size_t>(
+        std::to_chars(idBuf, idBuf + sizeof(idBuf), task.GetId()).ptr - idBuf)};
+    const std::string_view status = Task::toString(task.GetStatus());
+    const std::string_view created = Timestamp(task.GetCreatedAt(), m_created);
+    const auto updatedAt = task.GetUpdatedAt();
+    const std::string_view updated = updatedAt ? Timestamp(*updatedAt, m_updated) : "null";
+
+    switch (m_format)
+    {
+        case Format::TEXT:
+            m_buffer.Append("id: ");
+            m_buffer.Append(id);
+            m_buffer.Append("\ndescription: ");
+            AppendDisplayEscaped(task.GetDescription());
+            m_buffer.Append("\nstatus: ");
+            m_buffer.Append(status);
+            m_buffer.Append("\ncreatedAt: ");
+            m_buffer.Append(created);
+            m_buffer.Append("\nupdatedAt: ");
+            m_buffer.Append(updated);
+            m_buffer.Append("\n");
+            break;
+
+        case Format::TABLE:
+            if (!m_headerDone)
+                m_buffer.Append(TABLE_HEADER);
+            m_headerDone = true;
+            m_buffer.Append(Padding(id.size(), ID_WIDTH));
+            m_buffer.Append(id);
+            m_buffer.Append("  ");
+            m_buffer.Append(status);
+            m_buffer.Append(Padding(status.size(), STATUS_WIDTH));
+            m_buffer.Append("  ");
+            m_buffer.Append(created);
+            m_buffer.Append("  ");
+            m_buffer.Append(updated);
+            m_buffer.Append(Padding(updated.size(), TimeCodec::TIMESTAMP_SIZE));
+            m_buffer.Append("  ");
+            AppendDisplayEscaped(task.GetDescription());
+            m_buffer.Append("\n");
+            break;
+
+        case Format::JSONL:
+            m_buffer.Append("{\"id\":");
+            m_buffer.Append(id);
+            m_buffer.Append(",\"description\":\"");
+            m_buffer.AppendEscaped(task.GetDescription());
+            m_buffer.Append("\",\"status\":\"");
+            m_buffer.Append(status);
+            m_buffer.Append("\",\"createdAt\":\"");
+            m_buffer.Append(created);
+            if (updatedAt)
+            {
+                m_buffer.Append("\",\"updatedAt\":\"");
+                m_buffer.Append(updated);
+                m_buffer.Append("\"}\n");
+            }
+            else
+            {
+                m_buffer.Append("\",\"updatedAt\":null}\n");
+            }
+            break;
+
+        case Format::TSV:
+            m_buffer.Append(id);
+            m_buffer.Append("\t");
+            m_buffer.Append(status);
+            m_buffer.Append("\t");
+            m_buffer.Append(created);
+            m_buffer.Append("\t");
+            m_buffer.Append(updated);
+            m_buffer.Append("\t");
+            AppendTsvEscaped(task.GetDescription());
+            m_buffer.Append("\n");
+            break;
+    }
+
+    if (m_buffer.Size() >= CHUNK)
+        Flush();
+}
+
+void TaskPrinter::Flush()
+{
+    auto data = m_buffer.View();
+    if (!data.empty())
+        m_out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    m_buffer.Clear();
+}
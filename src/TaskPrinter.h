@@ -0,0 +1,64 @@
+#pragma once
+#include "JsonWriter.h"
+#include "Task.h"
+#include "TimeCodec.h"
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+// Formats tasks for the terminal or a pipe. Output collects in a reusable
+// buffer that goes to the stream in large chunks, and timestamps repeated
+// from the previous task are copied instead of formatted again.
+class TaskPrinter
+{
+public:
+    enum class Format
+    {
+        // Block of "field: value" lines per task, like Task::PrintTask.
+        // TEXT and TABLE show control characters in descriptions as
+        // escapes (\t, \n, \r, \xHH), so a task keeps its lines and columns.
+        TEXT,
+        // Header plus one aligned row per task, description last
+        TABLE,
+        // One JSON object per line
+        JSONL,
+        // Tab-separated fields in table order; tabs, newlines and
+        // backslashes in descriptions are escaped
+        TSV
+    };
+
+    explicit TaskPrinter(std::ostream& out, Format format = Format::TEXT);
+    ~TaskPrinter();
+    TaskPrinter(const TaskPrinter&) = delete;
+    TaskPrinter& operator=(const TaskPrinter&) = delete;
+
+    void Print(const Task& task);
+    // Writes the buffer out; done automatically when it is full and on
+    // destruction
+    void Flush();
+
+    static std::optional<Format> ParseFormat(std::string_view name) noexcept;
+
+private:
+    static constexpr size_t CHUNK = 64 * 1024;
+
+    struct CachedTimestamp
+    {
+        std::chrono::system_clock::time_point second = std::chrono::system_clock::time_point::min();
+        char text[TimeCodec::TIMESTAMP_SIZE];
+    };
+
+    // Formats tp, reusing the cache entry if it falls into the same second
+    std::string_view Timestamp(std::chrono::system_clock::time_point tp, CachedTimestamp& cache);
+    void AppendTsvEscaped(std::string_view text);
+    void AppendDisplayEscaped(std::string_view text);
+
+    std::ostream& m_out;
+    Format m_format;
+    bool m_headerDone = false;
+    JsonWriter m_buffer;
+    CachedTimestamp m_created;
+    CachedTimestamp m_updated;
+};
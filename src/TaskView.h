@@ -0,0 +1,63 @@
+#pragma once
+#include "Task.h"
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Non-owning result of a TaskList query. Holds pointers into the list, so
+// it stays valid only until the list is modified; nothing is copied.
+class TaskView
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Task;
+        using difference_type = std::ptrdiff_t;
+        using reference = const Task&;
+        using pointer = const Task*;
+
+        Iterator() = default;
+        explicit Iterator(const Task* const* it) noexcept : m_it(it) {}
+
+        reference operator*() const noexcept { return **m_it; }
+        pointer operator->() const noexcept { return *m_it; }
+        reference operator[](difference_type n) const noexcept { return *m_it[n]; }
+
+        Iterator& operator++() noexcept { ++m_it; return *this; }
+        Iterator operator++(int) noexcept { return Iterator(m_it++); }
+        Iterator& operator--() noexcept { --m_it; return *this; }
+        Iterator operator--(int) noexcept { return Iterator(m_it--); }
+        Iterator& operator+=(difference_type n) noexcept { m_it += n; return *this; }
+        Iterator& operator-=(difference_type n) noexcept { m_it -= n; return *this; }
+
+        friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+        friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+        friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(Iterator a, Iterator b) noexcept { return a.m_it - b.m_it; }
+        friend bool operator==(Iterator a, Iterator b) noexcept = default;
+        friend auto operator<=>(Iterator a, Iterator b) noexcept = default;
+
+    private:
+        const Task* const* m_it = nullptr;
+    };
+
+    TaskView() = default;
+    explicit TaskView(std::vector<const Task*> tasks) noexcept : m_tasks(std::move(tasks)) {}
+
+    Iterator begin() const noexcept { return Iterator(m_tasks.data()); }
+    Iterator end() const noexcept { return Iterator(m_tasks.data() + m_tasks.size()); }
+    size_t size() const noexcept { return m_tasks.size(); }
+    bool empty() const noexcept { return m_tasks.empty(); }
+    const Task& operator[](size_t i) const noexcept { return *m_tasks[i]; }
+
+    // Copies the tasks, for callers that outlive the list
+    std::vector<Task> ToVector() const { return {begin(), end()}; }
+
+private:
+    std::vector<const Task*> m_tasks;
+};
@@ -0,0 +1,160 @@
+#include "TimeCodec.h"
+
+#include <cstdint>
+#include <ctime>
+
+namespace
+{
+    namespace chrono = std::chrono;
+
+    constexpr int64_t SECONDS_PER_DAY = 86400;
+    constexpr int64_t OFFSET_WINDOW = 900;
+    constexpr size_t OFFSET_CACHE_SIZE = 64;
+
+    // Howard Hinnant's days_from_civil / civil_from_days
+    constexpr int64_t DaysFromCivil(int64_t y, unsigned m, unsigned d) noexcept
+    {
+        y -= m <= 2;
+        const int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    struct Civil
+    {
+        int64_t year;
+        unsigned month;
+        unsigned day;
+    };
+
+    constexpr Civil CivilFromDays(int64_t z) noexcept
+    {
+        z += 719468;
+        const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+        return {static_cast<int64_t>(yoe) + era * 400 + (m <= 2), m, d};
+    }
+
+    constexpr int64_t FloorDiv(int64_t a, int64_t b) noexcept
+    {
+        return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+    }
+
+    // Local UTC offset in seconds at the UTC instant t
+    int64_t QueryOffset(int64_t t) noexcept
+    {
+        std::time_t tt = static_cast<std::time_t>(t);
+        std::tm tm{};
+        #ifdef _WIN32
+            localtime_s(&tm, &tt);
+        #else
+            localtime_r(&tt, &tm);
+        #endif
+        int64_t local = DaysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * SECONDS_PER_DAY
+            + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+        return local - t;
+    }
+
+    int64_t OffsetAt(int64_t t) noexcept
+    {
+        struct Entry
+        {
+            int64_t window = INT64_MIN;
+            int64_t offset = 0;
+        };
+        thread_local Entry cache[OFFSET_CACHE_SIZE];
+
+        const int64_t window = FloorDiv(t, OFFSET_WINDOW);
+        Entry& entry = cache[static_cast<uint64_t>(window) % OFFSET_CACHE_SIZE];
+        if (entry.window != window)
+        {
+            entry.window = window;
+            entry.offset = QueryOffset(window * OFFSET_WINDOW);
+        }
+        return entry.offset;
+    }
+
+    void Write2(char* out, unsigned value) noexcept
+    {
+        out[0] = static_cast<char>('0' + value / 10);
+        out[1] = static_cast<char>('0' + value % 10);
+    }
+
+    bool Read(std::string_view text, size_t pos, size_t len, unsigned& value) noexcept
+    {
+        value = 0;
+        for (size_t i = pos; i < pos + len; ++i)
+        {
+            unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+            if (digit > 9)
+                return false;
+            value = value * 10 + digit;
+        }
+        return true;
+    }
+
+    constexpr bool IsLeap(unsigned y) noexcept
+    {
+        return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    }
+}
+
+void TimeCodec::Format(chrono::system_clock::time_point tp, char* out) noexcept
+{
+    const int64_t t = chrono::floor<chrono::seconds>(tp.time_since_epoch()).count();
+    const int64_t local = t + OffsetAt(t);
+    const int64_t days = FloorDiv(local, SECONDS_PER_DAY);
+    const int64_t secs = local - days * SECONDS_PER_DAY;
+    const Civil date = CivilFromDays(days);
+
+    unsigned year = static_cast<unsigned>(date.year < 0 ? 0 : date.year % 10000);
+    out[0] = static_cast<char>('0' + year / 1000);
+    out[1] = static_cast<char>('0' + year / 100 % 10);
+    Write2(out + 2, year % 100);
+    out[4] = '-';
+    Write2(out + 5, date.month);
+    out[7] = '-';
+    Write2(out + 8, date.day);
+    out[10] = ' ';
+    Write2(out + 11, static_cast<unsigned>(secs / 3600));
+    out[13] = ':';
+    Write2(out + 14, static_cast<unsigned>(secs / 60 % 60));
+    out[16] = ':';
+    Write2(out + 17, static_cast<unsigned>(secs % 60));
+}
+
+std::optional<chrono::system_clock::time_point> TimeCodec::Parse(std::string_view text) noexcept
+{
+    if (text.size() != TIMESTAMP_SIZE || text[4] != '-' || text[7] != '-'
+        || text[10] != ' ' || text[13] != ':' || text[16] != ':')
+        return std::nullopt;
+
+    unsigned year, month, day, hour, minute, second;
+    if (!Read(text, 0, 4, year) || !Read(text, 5, 2, month) || !Read(text, 8, 2, day)
+        || !Read(text, 11, 2, hour) || !Read(text, 14, 2, minute) || !Read(text, 17, 2, second))
+        return std::nullopt;
+
+    static constexpr unsigned char monthDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month < 1 || month > 12 || day < 1 || hour > 23 || minute > 59 || second > 60)
+        return std::nullopt;
+    if (day > monthDays[month - 1] + (month == 2 && IsLeap(year) ? 1u : 0u))
+        return std::nullopt;
+
+    const int64_t local = DaysFromCivil(year, month, day) * SECONDS_PER_DAY
+        + hour * 3600 + minute * 60 + second;
+
+    // Solve local = t + offset(t); converges in two steps except inside
+    // DST gaps and overlaps, where either neighbouring offset is accepted
+    int64_t t = local - OffsetAt(local);
+    t = local - OffsetAt(t);
+
+    return chrono::system_clock::time_point(
+        chrono::duration_cast<chrono::system_clock::duration>(chrono::seconds(t)));
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+// Allocation-free codec for the fixed "YYYY-MM-DD HH:MM:SS" local time
+// format of the store. Calendar math is done arithmetically; the local UTC
+// offset is looked up in a small per-thread cache keyed by 15 minute
+// windows, so the C library is only asked once per window.
+namespace TimeCodec
+{
+    inline constexpr size_t TIMESTAMP_SIZE = 19;
+
+    // Writes exactly TIMESTAMP_SIZE characters to out, no terminator
+    void Format(std::chrono::system_clock::time_point tp, char* out) noexcept;
+
+    // Parses the fixed format only; returns nullopt on any deviation
+    std::optional<std::chrono::system_clock::time_point> Parse(std::string_view text) noexcept;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace testutil
+{
+    // <stem>-<suite>.<test>-<pid><extension> in the temp directory. Test
+    // binaries run in parallel under ctest -j, so no two tests may share a
+    // store or the .lock and .journal files next to it.
+    inline std::filesystem::path TempPath(std::string_view stem, std::string_view extension)
+    {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        std::string name{stem};
+        if (info)
+            name += std::string("-") + info->test_suite_name() + "." + info->name();
+        #ifdef _WIN32
+            name += "-" + std::to_string(::_getpid());
+        #else
+            name += "-" + std::to_string(::getpid());
+        #endif
+        name += extension;
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    // Removes a store and the side files a TaskList creates next to it
+    inline void RemoveStoreFiles(const std::filesystem::path& store)
+    {
+        std::error_code ec;
+        std::filesystem::remove(store, ec);
+        for (const char* suffix : {".journal", ".lock", ".tmp"})
+        {
+            auto side = store;
+            side += suffix;
+            std::filesystem::remove(side, ec);
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#include "../src/TaskList.h"
+#include "../src/BinarySnapshot.h"
+#include <gtest/gtest.h>
+#include "TestUtil.h"
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <vector>
+
+class BinarySnapshotTest : public ::testing::Test {
+protected:
+    std::filesystem::path testJsonPath;
+    std::filesystem::path testBinPath;
+
+    void SetUp() override {
+        testJsonPath = testutil::TempPath("test-binary-tracker", ".json");
+        testBinPath = testutil::TempPath("test-binary-tracker", ".bin");
+        std::filesystem::remove(testJsonPath);
+        std::filesystem::remove(testBinPath);
+    }
+
+    void TearDown() override {
+        testutil::RemoveStoreFiles(testJsonPath);
+        testutil::RemoveStoreFiles(testBinPath);
+    }
+
+    std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    std::vector<Task> SampleTasks() {
+        auto now = std::chrono::system_clock::now();
+        std::vector<Task> tasks;
+        tasks.emplace_back(1, "First", Task::Status::TODO, now, std::nullopt);
+        tasks.emplace_back(2, "Task with \"quotes\", \n newlines and unicode: 🚀",
+            Task::Status::IN_PROGRESS, now, now + std::chrono::seconds(5));
+        tasks.emplace_back(5, "", Task::Status::DONE, now - std::chrono::hours(1), now);
+        return tasks;
+    }
+};
+
+TEST_F(BinarySnapshotTest, EncodeReadRoundTrip) {
+    auto tasks = SampleTasks();
+    std::string buffer;
+    ASSERT_TRUE(BinarySnapshot::Encode(tasks, buffer));
+    EXPECT_TRUE(BinarySnapshot::IsBinary(buffer));
+
+    std::vector<Task> decoded;
+    ASSERT_TRUE(BinarySnapshot::Read(buffer, decoded));
+    ASSERT_EQ(decoded.size(), tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        EXPECT_EQ(decoded[i].GetId(), tasks[i].GetId());
+        EXPECT_EQ(decoded[i].GetDescription(), tasks[i].GetDescription());
+        EXPECT_EQ(decoded[i].GetStatus(), tasks[i].GetStatus());
+        EXPECT_EQ(decoded[i].GetCreatedAt(), tasks[i].GetCreatedAt());
+        EXPECT_EQ(decoded[i].GetUpdatedAt(), tasks[i].GetUpdatedAt());
+        EXPECT_TRUE(decoded[i].IsBorrowed());
+    }
+}
+
+TEST_F(BinarySnapshotTest, EmptySnapshot) {
+    std::string buffer;
+    ASSERT_TRUE(BinarySnapshot::Encode({}, buffer));
+
+    std::vector<Task> decoded;
+    EXPECT_TRUE(BinarySnapshot::Read(buffer, decoded));
+    EXPECT_TRUE(decoded.empty());
+}
+
+TEST_F(BinarySnapshotTest, KeepsNextId) {
+    std::string buffer;
+    ASSERT_TRUE(BinarySnapshot::Encode(SampleTasks(), buffer, 42));
+    EXPECT_EQ(BinarySnapshot::NextId(buffer), 42);
+    std::vector<Task> decoded;
+    EXPECT_TRUE(BinarySnapshot::Read(buffer, decoded));
+
+    // Snapshots written without one leave the ids to decide
+    ASSERT_TRUE(BinarySnapshot::Encode(SampleTasks(), buffer));
+    EXPECT_EQ(BinarySnapshot::NextId(buffer), 0);
+}
+
+TEST_F(BinarySnapshotTest, RejectsCorruption) {
+    std::string buffer;
+    ASSERT_TRUE(BinarySnapshot::Encode(SampleTasks(), buffer));
+    std::vector<Task> decoded;
+
+    std::string flipped = buffer;
+    flipped[flipped.size() - 3] ^= 0x20;
+    EXPECT_FALSE(BinarySnapshot::Read(flipped, decoded));
+
+    std::string truncated = buffer.substr(0, buffer.size() - 1);
+    EXPECT_FALSE(BinarySnapshot::Read(truncated, decoded));
+
+    std::string version = buffer;
+    version[8] = 99;
+    EXPECT_FALSE(BinarySnapshot::Read(version, decoded));
+
+    EXPECT_FALSE(BinarySnapshot::Read("[]", decoded));
+}
+
+TEST_F(BinarySnapshotTest, TaskListLoadsBinaryStore) {
+    ASSERT_TRUE(BinarySnapshot::Write(SampleTasks(), testBinPath));
+
+    TaskList tl(testBinPath);
+    ASSERT_EQ(tl.Size(), 3);
+    auto inProgress = tl.GetByStatus(Task::Status::IN_PROGRESS);
+    ASSERT_EQ(inProgress.size(), 1);
+    EXPECT_EQ(inProgress[0].GetDescription(), "Task with \"quotes\", \n newlines and unicode: 🚀");
+}
+
+TEST_F(BinarySnapshotTest, TaskListKeepsBinaryFormatOnSave) {
+    ASSERT_TRUE(BinarySnapshot::Write(SampleTasks(), testBinPath));
+    {
+        TaskList tl(testBinPath);
+        EXPECT_TRUE(tl.AddTask("Added"));
+    }
+
+    EXPECT_TRUE(BinarySnapshot::IsBinary(ReadFile(testBinPath)));
+    TaskList tl(testBinPath);
+    EXPECT_EQ(tl.Size(), 4);
+}
+
+TEST_F(BinarySnapshotTest, ExportAndImportJson) {
+    auto now = std::chrono::system_clock::now();
+    std::vector<Task> tasks;
+    tasks.emplace_back(1, "First", Task::Status::TODO, now, std::nullopt);
+    tasks.emplace_back(2, "Second", Task::Status::IN_PROGRESS, now, now);
+    tasks.emplace_back(5, "Fifth", Task::Status::DONE, now, now);
+    ASSERT_TRUE(BinarySnapshot::Write(tasks, testBinPath));
+    {
+        TaskList tl(testBinPath);
+        ASSERT_TRUE(tl.SaveAs(testJsonPath, TaskListOptions::Format::JSON));
+    }
+    EXPECT_EQ(ReadFile(testJsonPath).front(), '[');
+
+    std::filesystem::remove(testBinPath);
+    {
+        TaskList tl(testJsonPath);
+        ASSERT_EQ(tl.Size(), 3);
+        ASSERT_TRUE(tl.SaveAs(testBinPath, TaskListOptions::Format::BINARY));
+    }
+
+    TaskList tl(testBinPath);
+    EXPECT_EQ(tl.Size(), 3);
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    ASSERT_EQ(todo.size(), 1);
+    EXPECT_EQ(todo[0].GetDescription(), "First");
+}
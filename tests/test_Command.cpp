@@ -0,0 +1,216 @@
+#include "../src/Command.h"
+#include <gtest/gtest.h>
+#include "TestUtil.h"
+#include <filesystem>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class CommandTest : public ::testing::Test {
+protected:
+    std::filesystem::path testJsonPath;
+    
+    void SetUp() override {
+        testJsonPath = testutil::TempPath("test-task-tracker-command", ".json");
+        std::filesystem::remove(testJsonPath);
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(testJsonPath);
+        for (const char* suffix : {".journal", ".lock"}) {
+            auto path = testJsonPath;
+            std::filesystem::remove(path += suffix);
+        }
+    }
+    
+    // Identity, size and mtime of the store and every file next to it
+    std::map<std::string, std::optional<FileStamp>> StoreFiles() {
+        std::map<std::string, std::optional<FileStamp>> files;
+        const auto prefix = testJsonPath.filename().string();
+        for (const auto& entry : std::filesystem::directory_iterator(testJsonPath.parent_path())) {
+            auto name = entry.path().filename().string();
+            if (name.starts_with(prefix))
+                files[name] = FileStamp::Of(entry.path());
+        }
+        return files;
+    }
+};
+
+TEST_F(CommandTest, SplitCommandLineHonoursQuotes) {
+    std::vector<std::string> args;
+    ASSERT_TRUE(SplitCommandLine("  update 3  \"Fix \\\"the\\\" parser\"  ", args));
+    EXPECT_EQ(args, (std::vector<std::string>{"update", "3", "Fix \"the\" parser"}));
+    
+    ASSERT_TRUE(SplitCommandLine("add pre\"fix me\"", args));
+    EXPECT_EQ(args, (std::vector<std::string>{"add", "prefix me"}));
+    
+    ASSERT_TRUE(SplitCommandLine("", args));
+    EXPECT_TRUE(args.empty());
+    
+    EXPECT_FALSE(SplitCommandLine("add \"unterminated", args));
+}
+
+TEST_F(CommandTest, FormatCommandLineRoundTrips) {
+    std::string desc = "Say \"hi\"\nto C:\\temp";
+    char program[] = "add";
+    char empty[] = "";
+    std::vector<char*> argv = {program, desc.data(), empty};
+    
+    std::string line = FormatCommandLine(static_cast<int>(argv.size()), argv.data());
+    EXPECT_EQ(line.find('\n'), std::string::npos);
+    std::vector<std::string> args;
+    ASSERT_TRUE(SplitCommandLine(line, args));
+    EXPECT_EQ(args, (std::vector<std::string>{"add", desc, ""}));
+}
+
+TEST_F(CommandTest, ParseListOptions) {
+    auto command = ParseCommandLine("list done --sort updated --limit 20 --offset 5");
+    ASSERT_TRUE(command.has_value());
+    EXPECT_EQ(command->filter, "done");
+    ASSERT_TRUE(command->order.has_value());
+    EXPECT_EQ(command->order->key, TaskOrder::Key::UPDATED);
+    EXPECT_TRUE(command->order->descending);
+    EXPECT_EQ(command->order->limit, 20);
+    EXPECT_EQ(command->order->offset, 5);
+    
+    command = ParseCommandLine("list --limit 3");
+    ASSERT_TRUE(command.has_value());
+    EXPECT_TRUE(command->filter.empty());
+    EXPECT_EQ(command->order->key, TaskOrder::Key::ID);
+    EXPECT_FALSE(command->order->descending);
+    
+    command = ParseCommandLine("list --format jsonl");
+    ASSERT_TRUE(command.has_value());
+    EXPECT_EQ(command->format, TaskPrinter::Format::JSONL);
+    EXPECT_FALSE(command->order.has_value());
+    EXPECT_FALSE(ParseCommandLine("list --format xml").has_value());
+    
+    EXPECT_FALSE(ParseCommandLine("list").value().order.has_value());
+    EXPECT_FALSE(ParseCommandLine("list --sort size").has_value());
+    EXPECT_FALSE(ParseCommandLine("list --limit -1").has_value());
+    EXPECT_FALSE(ParseCommandLine("list --offset").has_value());
+    EXPECT_FALSE(ParseCommandLine("list todo done").has_value());
+}
+
+TEST_F(CommandTest, ListPrintsOnePage) {
+    {
+        TaskList tasks(testJsonPath);
+        for (const char* desc : {"first", "second", "third"})
+            ASSERT_TRUE(tasks.AddTask(desc));
+        ASSERT_TRUE(tasks.MarkTask(2, Task::Status::DONE));
+        
+        std::ostringstream out, err;
+        ASSERT_TRUE(ExecuteCommand(*ParseCommandLine("list --sort id --offset 1 --limit 1"), tasks, out, err));
+        EXPECT_EQ(out.str().find("first"), std::string::npos);
+        EXPECT_NE(out.str().find("second"), std::string::npos);
+        EXPECT_EQ(out.str().find("third"), std::string::npos);
+    }
+}
+
+TEST_F(CommandTest, ReadOnlyCommandsWriteNothing) {
+    TaskListOptions journaled;
+    journaled.persistence = TaskListOptions::Persistence::JOURNAL;
+    journaled.journalCompactBytes = 1 << 20;
+    {
+        TaskList tasks(testJsonPath);
+        for (const char* desc : {"write parser", "review parser", "deploy"})
+            ASSERT_TRUE(tasks.AddTask(desc));
+    }
+    {
+        // Leaves a journal behind that a compaction would fold in
+        TaskList tasks(testJsonPath, journaled);
+        ASSERT_TRUE(tasks.MarkTask(2, Task::Status::DONE));
+    }
+    const auto before = StoreFiles();
+    ASSERT_TRUE(before.contains(testJsonPath.filename().string() + ".journal"));
+    
+    TaskListOptions rewriting;
+    journaled.journalCompactBytes = 0;
+    for (const auto& options : {rewriting, journaled}) {
+        TaskList tasks(testJsonPath, options);
+        std::ostringstream out, err;
+        for (const char* line : {"list", "list done", "list --sort updated --limit 1", 
+            "list --format jsonl", "search parser"}) {
+            ASSERT_TRUE(ExecuteCommand(*ParseCommandLine(line), tasks, out, err)) << line;
+        }
+        EXPECT_FALSE(tasks.IsDirty());
+    }
+    EXPECT_EQ(StoreFiles(), before);
+}
+
+TEST_F(CommandTest, FreshJournalStoreIsNoError) {
+    // Like the CLI: one list per command, the store is not written yet
+    TaskListOptions journaled;
+    journaled.persistence = TaskListOptions::Persistence::JOURNAL;
+    testing::internal::CaptureStderr();
+    for (const char* line : {"add \"first\"", "list", "mark-done 1", "add \"second\"", "delete 1", "list"}) {
+        TaskList tasks(testJsonPath, journaled);
+        std::ostringstream out, err;
+        EXPECT_TRUE(ExecuteCommand(*ParseCommandLine(line), tasks, out, err)) << line;
+        EXPECT_EQ(err.str(), "") << line;
+    }
+    EXPECT_EQ(testing::internal::GetCapturedStderr(), "");
+    EXPECT_FALSE(std::filesystem::exists(testJsonPath));
+    
+    TaskList tasks(testJsonPath, journaled);
+    ASSERT_EQ(tasks.Size(), 1);
+    EXPECT_EQ(tasks.FindById(2)->GetDescription(), "second");
+}
+
+TEST_F(CommandTest, RunBatchAppliesAllCommands) {
+    std::istringstream in(
+        "# comment\n"
+        "add \"Task 1\"\n"
+        "add \"Task 2\"\r\n"
+        "\n"
+        "mark-done 1\n"
+        "update 2 \"Task 2 updated\"\n"
+        "add \"Task 3\"\n"
+        "delete 3\n");
+    std::ostringstream report;
+    
+    TaskList tl(testJsonPath);
+    auto result = RunBatch(in, tl, report);
+    EXPECT_EQ(result.commands, 6);
+    EXPECT_EQ(result.failed, 0);
+    EXPECT_EQ(tl.Size(), 2);
+    EXPECT_EQ(tl.CountByStatus(Task::Status::DONE), 1);
+    
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    ASSERT_EQ(todo.size(), 1);
+    EXPECT_EQ(todo[0].GetDescription(), "Task 2 updated");
+    
+    // Line numbers count skipped lines too
+    EXPECT_EQ(report.str(),
+        "line 2: ok\n"
+        "line 3: ok\n"
+        "line 5: ok\n"
+        "line 6: ok\n"
+        "line 7: ok\n"
+        "line 8: ok\n");
+}
+
+TEST_F(CommandTest, RunBatchReportsFailuresAndContinues) {
+    std::istringstream in(
+        "add \"Task 1\"\n"
+        "mark-done 7\n"
+        "frobnicate\n"
+        "add \"unterminated\n"
+        "batch\n"
+        "mark-in-progress 1\n");
+    std::ostringstream report;
+    
+    TaskList tl(testJsonPath);
+    auto result = RunBatch(in, tl, report);
+    EXPECT_EQ(result.commands, 6);
+    EXPECT_EQ(result.failed, 4);
+    EXPECT_EQ(report.str(),
+        "line 1: ok\n"
+        "line 2: failed\n"
+        "line 3: failed\n"
+        "line 4: failed\n"
+        "line 5: failed\n"
+        "line 6: ok\n");
+    EXPECT_EQ(tl.CountByStatus(Task::Status::IN_PROGRESS), 1);
+}
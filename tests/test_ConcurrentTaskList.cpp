@@ -0,0 +1,161 @@
+#include "../src/ConcurrentTaskList.h"
+#include <gtest/gtest.h>
+#include "TestUtil.h"
+#include <atomic>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
+
+class ConcurrentTaskListTest : public ::testing::Test {
+protected:
+    std::filesystem::path testJsonPath;
+    
+    void SetUp() override {
+        testJsonPath = testutil::TempPath("test-task-tracker-concurrent", ".json");
+        RemoveStore();
+    }
+    
+    void TearDown() override {
+        RemoveStore();
+    }
+    
+    void RemoveStore() {
+        testutil::RemoveStoreFiles(testJsonPath);
+    }
+    
+    // Everything a reader can observe has to agree within one snapshot
+    static void ExpectConsistent(const TaskSnapshot& snapshot) {
+        size_t count = 0;
+        size_t byStatus[3] = {};
+        int lastId = 0;
+        snapshot.ForEach([&](const Task& task) {
+            ++count;
+            ++byStatus[static_cast<size_t>(task.GetStatus())];
+            ASSERT_GT(task.GetId(), lastId);
+            lastId = task.GetId();
+            ASSERT_EQ(snapshot.FindById(task.GetId()), &task);
+        });
+        ASSERT_EQ(count, snapshot.Size());
+        for (auto status : {Task::Status::TODO, Task::Status::IN_PROGRESS, Task::Status::DONE}) {
+            ASSERT_EQ(snapshot.CountByStatus(status), byStatus[static_cast<size_t>(status)]);
+            ASSERT_EQ(snapshot.Select({.status = status}).size(), byStatus[static_cast<size_t>(status)]);
+        }
+    }
+};
+
+TEST_F(ConcurrentTaskListTest, SnapshotIsUnaffectedByLaterWrites) {
+    ConcurrentTaskList tasks(testJsonPath);
+    ASSERT_TRUE(tasks.AddTask("first"));
+    ASSERT_TRUE(tasks.AddTask("second"));
+    auto before = tasks.Snapshot();
+    
+    ASSERT_TRUE(tasks.UpdateTask(1, "changed"));
+    ASSERT_TRUE(tasks.MarkTask(1, Task::Status::DONE));
+    ASSERT_TRUE(tasks.RemoveTask(2));
+    ASSERT_TRUE(tasks.AddTask("third"));
+    auto after = tasks.Snapshot();
+    
+    EXPECT_LT(before->Version(), after->Version());
+    EXPECT_EQ(before->Size(), 2);
+    EXPECT_EQ(before->FindById(1)->GetDescription(), "first");
+    EXPECT_EQ(before->FindById(1)->GetStatus(), Task::Status::TODO);
+    EXPECT_NE(before->FindById(2), nullptr);
+    EXPECT_EQ(before->FindById(3), nullptr);
+    
+    EXPECT_EQ(after->Size(), 2);
+    EXPECT_EQ(after->FindById(1)->GetDescription(), "changed");
+    EXPECT_EQ(after->CountByStatus(Task::Status::DONE), 1);
+    EXPECT_EQ(after->FindById(2), nullptr);
+    EXPECT_EQ(after->FindById(3)->GetDescription(), "third");
+    ExpectConsistent(*before);
+    ExpectConsistent(*after);
+}
+
+TEST_F(ConcurrentTaskListTest, LoadsAndPersistsThroughTaskList) {
+    {
+        ConcurrentTaskList tasks(testJsonPath);
+        for (int i = 0; i < 600; ++i)
+            ASSERT_TRUE(tasks.AddTask("task " + std::to_string(i)));
+        ASSERT_TRUE(tasks.MarkTask(300, Task::Status::IN_PROGRESS));
+        EXPECT_FALSE(tasks.RemoveTask(601));
+    }
+    ConcurrentTaskList tasks(testJsonPath);
+    auto snapshot = tasks.Snapshot();
+    ASSERT_EQ(snapshot->Size(), 600);
+    EXPECT_EQ(snapshot->FindById(300)->GetStatus(), Task::Status::IN_PROGRESS);
+    EXPECT_EQ(snapshot->Select({.minId = 256, .maxId = 260}).size(), 5);
+    ExpectConsistent(*snapshot);
+}
+
+TEST_F(ConcurrentTaskListTest, RemovingMostTasksCompacts) {
+    ConcurrentTaskList tasks(testJsonPath);
+    for (int i = 0; i < 3000; ++i)
+        ASSERT_TRUE(tasks.AddTask("task"));
+    for (int id = 1; id <= 2900; ++id)
+        ASSERT_TRUE(tasks.RemoveTask(id));
+    auto snapshot = tasks.Snapshot();
+    ASSERT_EQ(snapshot->Size(), 100);
+    EXPECT_EQ(snapshot->FindById(2901)->GetId(), 2901);
+    ASSERT_TRUE(tasks.MarkTask(3000, Task::Status::DONE));
+    EXPECT_EQ(tasks.Snapshot()->CountByStatus(Task::Status::DONE), 1);
+    ExpectConsistent(*tasks.Snapshot());
+}
+
+// Writers add, mark and remove while readers check every snapshot they get
+TEST_F(ConcurrentTaskListTest, ReadersSeeConsistentSnapshotsUnderWrites) {
+    ConcurrentTaskList tasks(testJsonPath);
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_TRUE(tasks.AddTask("seed"));
+    
+    std::atomic<bool> writing{true};
+    std::atomic<size_t> checked{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            uint64_t lastVersion = 0;
+            while (writing) {
+                auto snapshot = tasks.Snapshot();
+                ASSERT_GE(snapshot->Version(), lastVersion);
+                lastVersion = snapshot->Version();
+                ExpectConsistent(*snapshot);
+                ++checked;
+            }
+        });
+    }
+    
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&, w] {
+            std::mt19937 rng(w);
+            for (int step = 0; step < 3000; ++step) {
+                int id = static_cast<int>(rng() % 2000) + 1;
+                switch (rng() % 4) {
+                    case 0: tasks.AddTask("added"); break;
+                    case 1: tasks.MarkTask(id, Task::Status::IN_PROGRESS); break;
+                    case 2: tasks.MarkTask(id, Task::Status::DONE); break;
+                    case 3: tasks.RemoveTask(id); break;
+                }
+            }
+        });
+    }
+    for (auto& writer : writers)
+        writer.join();
+    writing = false;
+    for (auto& reader : readers)
+        reader.join();
+    
+    EXPECT_GT(checked.load(), 0u);
+    ExpectConsistent(*tasks.Snapshot());
+    
+    // The wrapped list persisted the same state
+    auto final = tasks.Snapshot();
+    ASSERT_TRUE(tasks.Flush());
+    TaskList reloaded(testJsonPath);
+    ASSERT_EQ(reloaded.Size(), final->Size());
+    for (const Task& task : reloaded.Select({})) {
+        const Task* published = final->FindById(task.GetId());
+        ASSERT_NE(published, nullptr);
+        EXPECT_EQ(published->GetStatus(), task.GetStatus());
+    }
+}
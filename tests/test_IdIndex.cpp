@@ -0,0 +1,69 @@
+#include "../src/IdIndex.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+TEST(IdIndexTest, InsertFindErase) {
+    IdIndex index;
+    EXPECT_FALSE(index.Find(1).has_value());
+    EXPECT_FALSE(index.Erase(1));
+    
+    EXPECT_TRUE(index.Insert(1, 0));
+    EXPECT_TRUE(index.Insert(7, 1));
+    EXPECT_FALSE(index.Insert(1, 5));
+    EXPECT_EQ(index.Size(), 2);
+    EXPECT_EQ(index.Find(1), 0);
+    EXPECT_EQ(index.Find(7), 1);
+    
+    EXPECT_TRUE(index.Erase(1));
+    EXPECT_FALSE(index.Find(1).has_value());
+    EXPECT_EQ(index.Find(7), 1);
+    EXPECT_EQ(index.Size(), 1);
+}
+
+TEST(IdIndexTest, GrowsPastInitialCapacity) {
+    IdIndex index;
+    for (int id = 1; id <= 10000; ++id) {
+        ASSERT_TRUE(index.Insert(id, static_cast<size_t>(id - 1)));
+    }
+    for (int id = 1; id <= 10000; ++id) {
+        ASSERT_EQ(index.Find(id), static_cast<size_t>(id - 1));
+    }
+    EXPECT_FALSE(index.Find(0).has_value());
+    EXPECT_FALSE(index.Find(10001).has_value());
+    
+    index.Clear();
+    EXPECT_EQ(index.Size(), 0);
+    EXPECT_FALSE(index.Find(5).has_value());
+}
+
+// Erasing inside long probe chains has to keep every other id reachable
+TEST(IdIndexTest, RandomOperationsMatchModel) {
+    IdIndex index;
+    std::unordered_map<int, size_t> model;
+    std::mt19937 rng{11};
+    for (int step = 0; step < 50000; ++step) {
+        int id = static_cast<int>(rng() % 2000) - 100;
+        switch (rng() % 3) {
+            case 0:
+            case 1: {
+                size_t slot = rng() % 100000;
+                bool inserted = model.emplace(id, slot).second;
+                ASSERT_EQ(index.Insert(id, slot), inserted);
+                break;
+            }
+            case 2:
+                ASSERT_EQ(index.Erase(id), model.erase(id) == 1);
+                break;
+        }
+        ASSERT_EQ(index.Size(), model.size());
+    }
+    for (int id = -100; id < 1900; ++id) {
+        auto it = model.find(id);
+        if (it == model.end()) {
+            ASSERT_FALSE(index.Find(id).has_value());
+        } else {
+            ASSERT_EQ(index.Find(id), it->second);
+        }
+    }
+}
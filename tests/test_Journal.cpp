@@ -0,0 +1,272 @@
+#include "../src/TaskList.h"
+#include "../src/Journal.h"
+#include <gtest/gtest.h>
+#include "TestUtil.h"
+#include <cstdlib>
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <vector>
+
+class JournalTest : public ::testing::Test {
+protected:
+    std::filesystem::path testJsonPath;
+    std::filesystem::path testJournalPath;
+    TaskListOptions options;
+
+    void SetUp() override {
+        testJsonPath = testutil::TempPath("test-journal-tracker", ".json");
+        testJournalPath = testJsonPath;
+        testJournalPath += ".journal";
+        options.persistence = TaskListOptions::Persistence::JOURNAL;
+        RemoveFiles();
+    }
+
+    void TearDown() override {
+        RemoveFiles();
+    }
+
+    void RemoveFiles() {
+        std::filesystem::remove(testJsonPath);
+        std::filesystem::remove(testJournalPath);
+        auto lock = testJsonPath;
+        lock += ".lock";
+        std::filesystem::remove(lock);
+    }
+
+    // Temp files of saves that were not cleaned up
+    size_t CountTempFiles() {
+        auto prefix = testJsonPath.filename().string() + ".tmp";
+        size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(testJsonPath.parent_path())) {
+            if (entry.path().filename().string().starts_with(prefix))
+                ++count;
+        }
+        return count;
+    }
+
+    void CreateTestJsonFile(const std::string& content) {
+        std::ofstream file(testJsonPath);
+        file << content;
+        file.close();
+    }
+
+    std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    const std::string snapshot = R"([
+    {
+        "id": 1,
+        "description": "Task 1",
+        "status": "TODO",
+        "createdAt": "2025-08-02 23:30:00",
+        "updatedAt": "null"
+    },
+    {
+        "id": 2,
+        "description": "Task 2",
+        "status": "TODO",
+        "createdAt": "2025-08-02 23:31:00",
+        "updatedAt": "null"
+    }
+]
+)";
+};
+
+// Journal Tests
+TEST_F(JournalTest, AppendAndReplayRoundTrip) {
+    auto now = std::chrono::system_clock::now();
+    {
+        Journal journal(testJournalPath);
+        ASSERT_TRUE(journal.Replay([](const Journal::Record&) {}));
+        EXPECT_TRUE(journal.Append({Journal::Record::Type::ADD, 7, Task::Status::TODO,
+            now, "multi\nline \"description\""}));
+        EXPECT_TRUE(journal.Append({Journal::Record::Type::MARK, 7, Task::Status::DONE,
+            now, {}}));
+        EXPECT_GT(journal.SizeBytes(), 0);
+    }
+
+    std::vector<Journal::Record> records;
+    std::vector<std::string> descriptions;
+    Journal journal(testJournalPath);
+    ASSERT_TRUE(journal.Replay([&](const Journal::Record& r) {
+        records.push_back(r);
+        descriptions.emplace_back(r.description);
+    }));
+
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].type, Journal::Record::Type::ADD);
+    EXPECT_EQ(records[0].id, 7);
+    EXPECT_EQ(records[0].timestamp, now);
+    EXPECT_EQ(descriptions[0], "multi\nline \"description\"");
+    EXPECT_EQ(records[1].type, Journal::Record::Type::MARK);
+    EXPECT_EQ(records[1].status, Task::Status::DONE);
+}
+
+TEST_F(JournalTest, MutationsDoNotRewriteStore) {
+    CreateTestJsonFile(snapshot);
+    {
+        TaskList tl(testJsonPath, options);
+        EXPECT_TRUE(tl.AddTask("Task 3"));
+        EXPECT_TRUE(tl.MarkTask(1, Task::Status::DONE));
+    }
+
+    EXPECT_EQ(ReadFile(testJsonPath), snapshot);
+    EXPECT_TRUE(std::filesystem::exists(testJournalPath));
+
+    TaskList tl(testJsonPath, options);
+    EXPECT_EQ(tl.Size(), 3);
+    EXPECT_EQ(tl.GetByStatus(Task::Status::DONE).size(), 1);
+}
+
+TEST_F(JournalTest, RecoveryAfterCrash) {
+    CreateTestJsonFile(snapshot);
+
+    // The child process mutates and dies without running any destructor
+    EXPECT_EXIT({
+        TaskList tl(testJsonPath, options);
+        tl.AddTask("Added before crash");
+        tl.UpdateTask(1, "Task 1 updated");
+        tl.MarkTask(2, Task::Status::IN_PROGRESS);
+        tl.RemoveTask(1);
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+
+    TaskList tl(testJsonPath, options);
+    ASSERT_EQ(tl.Size(), 2);
+
+    auto inProgress = tl.GetByStatus(Task::Status::IN_PROGRESS);
+    ASSERT_EQ(inProgress.size(), 1);
+    EXPECT_EQ(inProgress[0].GetId(), 2);
+
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    ASSERT_EQ(todo.size(), 1);
+    EXPECT_EQ(todo[0].GetId(), 3);
+    EXPECT_EQ(todo[0].GetDescription(), "Added before crash");
+}
+
+TEST_F(JournalTest, TornRecordIsIgnored) {
+    CreateTestJsonFile(snapshot);
+    {
+        TaskList tl(testJsonPath, options);
+        tl.AddTask("Complete record");
+    }
+
+    // Simulate a crash in the middle of an append
+    {
+        std::ofstream journal(testJournalPath, std::ios::app | std::ios::binary);
+        journal << "A 4 0 1754170125000000000 20:Torn rec";
+    }
+
+    {
+        TaskList tl(testJsonPath, options);
+        EXPECT_EQ(tl.Size(), 3);
+        EXPECT_TRUE(tl.AddTask("After recovery"));
+    }
+
+    TaskList tl(testJsonPath, options);
+    EXPECT_EQ(tl.Size(), 4);
+}
+
+TEST_F(JournalTest, HugeLengthIsRejected) {
+    // A length that wraps around in the bounds check
+    {
+        std::ofstream journal(testJournalPath, std::ios::binary);
+        journal << "A 4 0 1754170125000000000 18446744073709551615:abc 00000000\n";
+    }
+
+    size_t applied = 0;
+    Journal journal(testJournalPath);
+    ASSERT_TRUE(journal.Replay([&](const Journal::Record&) { ++applied; }));
+    EXPECT_EQ(applied, 0);
+}
+
+TEST_F(JournalTest, CompactionPastThreshold) {
+    CreateTestJsonFile(snapshot);
+    options.journalCompactBytes = 1;
+    {
+        TaskList tl(testJsonPath, options);
+        tl.AddTask("Task 3");
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(testJournalPath));
+    EXPECT_NE(ReadFile(testJsonPath).find("Task 3"), std::string::npos);
+
+    TaskList tl(testJsonPath, options);
+    EXPECT_EQ(tl.Size(), 3);
+}
+
+TEST_F(JournalTest, CompactionReplacesStoreWithoutTempFiles) {
+    CreateTestJsonFile(snapshot);
+    options.journalCompactBytes = 1;
+    for (int i = 0; i < 3; ++i) {
+        TaskList tl(testJsonPath, options);
+        ASSERT_TRUE(tl.AddTask("Added " + std::to_string(i)));
+    }
+    
+    EXPECT_EQ(CountTempFiles(), 0);
+    TaskList tl(testJsonPath, options);
+    EXPECT_EQ(tl.Size(), 5);
+    ASSERT_TRUE(tl.SaveAs(testJsonPath, TaskListOptions::Format::BINARY));
+    EXPECT_EQ(CountTempFiles(), 0);
+}
+
+TEST_F(JournalTest, GroupCommitKeepsIncompleteGroup) {
+    CreateTestJsonFile(snapshot);
+    options.groupCommit = 4;
+    {
+        TaskList tl(testJsonPath, options);
+        for (int i = 0; i < 7; ++i)
+            ASSERT_TRUE(tl.AddTask("Grouped " + std::to_string(i)));
+    }
+    
+    TaskList tl(testJsonPath, options);
+    EXPECT_EQ(tl.Size(), 9);
+    EXPECT_EQ(tl.FindByKeyWord("Grouped").size(), 7);
+}
+
+TEST_F(JournalTest, ReplayOverCompactedStoreIsIdempotent) {
+    CreateTestJsonFile(snapshot);
+    {
+        TaskList tl(testJsonPath, options);
+        tl.AddTask("Task 3");
+        tl.RemoveTask(1);
+        tl.MarkTask(2, Task::Status::DONE);
+    }
+    auto journal = ReadFile(testJournalPath);
+
+    // Crash after the store was replaced but before the journal was cleared
+    options.journalCompactBytes = 1;
+    {
+        TaskList tl(testJsonPath, options);
+    }
+    {
+        std::ofstream out(testJournalPath, std::ios::binary);
+        out << journal;
+    }
+
+    options.journalCompactBytes = 1 << 20;
+    TaskList tl(testJsonPath, options);
+    EXPECT_EQ(tl.Size(), 2);
+    EXPECT_EQ(tl.GetByStatus(Task::Status::DONE).size(), 1);
+    EXPECT_EQ(tl.GetByStatus(Task::Status::TODO).size(), 1);
+}
+
+TEST_F(JournalTest, DeletingLastTaskIsPersisted) {
+    {
+        TaskList tl(testJsonPath, options);
+        tl.AddTask("Only task");
+    }
+    {
+        TaskList tl(testJsonPath, options);
+        ASSERT_EQ(tl.Size(), 1);
+        EXPECT_TRUE(tl.RemoveTask(1));
+    }
+
+    TaskList tl(testJsonPath, options);
+    EXPECT_EQ(tl.Size(), 0);
+}
@@ -1,7 +1,10 @@
 #include "../src/TaskList.h"
 #include <gtest/gtest.h>
+#include "TestUtil.h"
 #include <fstream>
 #include <filesystem>
+#include <chrono>
+#include <vector>
 
 class JsonParsingTest : public ::testing::Test {
 protected:
@@ -9,8 +12,8 @@ protected:
     std::filesystem::path testJsonTmpPath;
     
     void SetUp() override {
-        testJsonPath = std::filesystem::temp_directory_path() / "test-task-tracker.json";
-        testJsonTmpPath = std::filesystem::temp_directory_path() / "test-task-tracker.json.tmp";
+        testJsonPath = testutil::TempPath("test-task-tracker", ".json");
+        testJsonTmpPath = testJsonPath.string() + ".tmp";
         
         if (std::filesystem::exists(testJsonPath)) {
             std::filesystem::remove(testJsonPath);
@@ -21,9 +24,7 @@ protected:
     }
     
     void TearDown() override {
-        if (std::filesystem::exists(testJsonPath)) {
-            std::filesystem::remove(testJsonPath);
-        }
+        testutil::RemoveStoreFiles(testJsonPath);
         if (std::filesystem::exists(testJsonTmpPath)) {
             std::filesystem::remove(testJsonTmpPath);
         }
@@ -36,10 +37,6 @@ protected:
     }
 };
 
-// Note: These tests would require modifying the TaskList class to accept a custom file path
-// for testing purposes. The current design makes it difficult to test file operations
-// without affecting the actual task-tracker.json file.
-
 TEST_F(JsonParsingTest, ValidJsonFormat) {
     std::string validJson = R"([
     {
@@ -52,7 +49,15 @@ TEST_F(JsonParsingTest, ValidJsonFormat) {
 ])";
     
     CreateTestJsonFile(validJson);
-    // Would test TaskList loading here if we had dependency injection
+    TaskList tl(testJsonPath);
+    ASSERT_EQ(tl.Size(), 1);
+    
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    ASSERT_EQ(todo.size(), 1);
+    EXPECT_EQ(todo[0].GetId(), 1);
+    EXPECT_EQ(todo[0].GetDescription(), "Test Task");
+    EXPECT_EQ(todo[0].GetCreatedAtString(), "2025-08-02 23:30:00");
+    EXPECT_EQ(todo[0].GetUpdatedAt(), std::nullopt);
 }
 
 TEST_F(JsonParsingTest, MultipleTasksJson) {
@@ -81,13 +86,21 @@ TEST_F(JsonParsingTest, MultipleTasksJson) {
 ])";
     
     CreateTestJsonFile(multipleTasksJson);
-    // Would test TaskList loading here
+    TaskList tl(testJsonPath);
+    ASSERT_EQ(tl.Size(), 3);
+    
+    auto inProgress = tl.GetByStatus(Task::Status::IN_PROGRESS);
+    ASSERT_EQ(inProgress.size(), 1);
+    EXPECT_EQ(inProgress[0].GetId(), 2);
+    EXPECT_EQ(inProgress[0].GetUpdatedAtString(), "2025-08-02 23:35:00");
+    EXPECT_EQ(tl.GetByStatus(Task::Status::DONE).size(), 1);
 }
 
 TEST_F(JsonParsingTest, EmptyJsonArray) {
     std::string emptyJson = "[]";
     CreateTestJsonFile(emptyJson);
-    // Would test empty TaskList loading here
+    TaskList tl(testJsonPath);
+    EXPECT_EQ(tl.Size(), 0);
 }
 
 TEST_F(JsonParsingTest, InvalidJsonFormat) {
@@ -103,7 +116,8 @@ TEST_F(JsonParsingTest, InvalidJsonFormat) {
 )";
     
     CreateTestJsonFile(invalidJson);
-    // Would test error handling here
+    TaskList tl(testJsonPath);
+    EXPECT_EQ(tl.Size(), 0);
 }
 
 TEST_F(JsonParsingTest, MissingRequiredFields) {
@@ -116,7 +130,8 @@ TEST_F(JsonParsingTest, MissingRequiredFields) {
 ])";
     
     CreateTestJsonFile(incompleteJson);
-    // Would test error handling here
+    TaskList tl(testJsonPath);
+    EXPECT_EQ(tl.Size(), 0);
 }
 
 TEST_F(JsonParsingTest, InvalidStatusValue) {
@@ -131,7 +146,8 @@ TEST_F(JsonParsingTest, InvalidStatusValue) {
 ])";
     
     CreateTestJsonFile(invalidStatusJson);
-    // Would test error handling here
+    TaskList tl(testJsonPath);
+    EXPECT_EQ(tl.Size(), 0);
 }
 
 TEST_F(JsonParsingTest, InvalidDateFormat) {
@@ -146,7 +162,13 @@ TEST_F(JsonParsingTest, InvalidDateFormat) {
 ])";
     
     CreateTestJsonFile(invalidDateJson);
-    // Would test date parsing error handling here
+    auto before = std::chrono::system_clock::now() - std::chrono::seconds(1);
+    TaskList tl(testJsonPath);
+    ASSERT_EQ(tl.Size(), 1);
+    
+    // Falls back to the current time
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    EXPECT_GE(todo[0].GetCreatedAt(), before);
 }
 
 TEST_F(JsonParsingTest, FutureDateHandling) {
@@ -161,7 +183,13 @@ TEST_F(JsonParsingTest, FutureDateHandling) {
 ])";
     
     CreateTestJsonFile(futureDateJson);
-    // Would test future date handling here
+    TaskList tl(testJsonPath);
+    ASSERT_EQ(tl.Size(), 1);
+    
+    // More than one day ahead is treated as a parsing error
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    EXPECT_LE(todo[0].GetCreatedAt(), 
+        std::chrono::system_clock::now() + std::chrono::hours(24));
 }
 
 TEST_F(JsonParsingTest, SpecialCharactersInDescription) {
@@ -176,7 +204,12 @@ TEST_F(JsonParsingTest, SpecialCharactersInDescription) {
 ])";
     
     CreateTestJsonFile(specialCharsJson);
-    // Would test special character handling here
+    TaskList tl(testJsonPath);
+    ASSERT_EQ(tl.Size(), 1);
+    
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    EXPECT_EQ(todo[0].GetDescription(), 
+        "Task with \"quotes\", \n newlines, \t tabs, and unicode: 🚀");
 }
 
 TEST_F(JsonParsingTest, VeryLongDescription) {
@@ -192,5 +225,267 @@ TEST_F(JsonParsingTest, VeryLongDescription) {
 ])";
     
     CreateTestJsonFile(longDescJson);
-    // Would test long description handling here
-} 
\ No newline at end of file
+    TaskList tl(testJsonPath);
+    ASSERT_EQ(tl.Size(), 1);
+    
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    EXPECT_EQ(todo[0].GetDescription(), longDesc);
+}
+
+// Reader Tests
+TEST_F(JsonParsingTest, ParseTasksUnicodeEscapes) {
+    std::string json = R"([{"id": 7, "description": "caf\u00e9 \ud83d\ude80 \/ \\",
+        "status": "DONE", "createdAt": "2025-08-02 23:30:00", "updatedAt": null}])";
+    
+    std::vector<Task> tasks;
+    ASSERT_TRUE(TaskList::ParseTasks(json, tasks));
+    ASSERT_EQ(tasks.size(), 1);
+    EXPECT_EQ(tasks[0].GetId(), 7);
+    EXPECT_EQ(tasks[0].GetDescription(), "caf\u00e9 🚀 / \\");
+    EXPECT_EQ(tasks[0].GetStatus(), Task::Status::DONE);
+    EXPECT_EQ(tasks[0].GetUpdatedAt(), std::nullopt);
+}
+
+TEST_F(JsonParsingTest, ParseTasksCopiesEscapedDescriptionsIntoArena) {
+    std::string json = R"([
+    {"id": 1, "description": "plain", "status": "TODO",
+     "createdAt": "2025-08-02 23:30:00", "updatedAt": null},
+    {"id": 2, "description": "say \"hi\"", "status": "DONE",
+     "createdAt": "2025-08-02 23:31:00", "updatedAt": null}
+])";
+    
+    StringArena arena;
+    std::vector<Task> tasks;
+    ASSERT_TRUE(TaskList::ParseTasks(json, tasks, true, &arena));
+    ASSERT_EQ(tasks.size(), 2);
+    EXPECT_TRUE(tasks[0].IsBorrowed());
+    EXPECT_TRUE(tasks[1].IsBorrowed());
+    EXPECT_EQ(tasks[1].GetDescription(), "say \"hi\"");
+    EXPECT_EQ(arena.BytesUsed(), tasks[1].GetDescription().size());
+    
+    // Copies own their description
+    Task copy = tasks[1];
+    arena.Release();
+    EXPECT_FALSE(copy.IsBorrowed());
+    EXPECT_EQ(copy.GetDescription(), "say \"hi\"");
+}
+
+TEST_F(JsonParsingTest, ParseTasksParallelMatchesSerial) {
+    // Some descriptions are escaped, some look like an object boundary
+    std::string json = "[\n";
+    for (int i = 1; i <= 60; ++i) {
+        std::string desc = i % 7 == 0 ? R"(a\"}, {\"b)" : i % 5 == 0 ? "x }, { y" : "task " + std::to_string(i);
+        json += "    {\"id\": " + std::to_string(i) + ", \"description\": \"" + desc
+            + "\", \"status\": \"" + (i % 2 ? "TODO" : "DONE")
+            + "\", \"createdAt\": \"2025-08-02 23:30:00\", \"updatedAt\": \"null\"}"
+            + (i < 60 ? ",\n" : "\n");
+    }
+    json += "]";
+
+    std::vector<Task> expected;
+    ASSERT_TRUE(TaskList::ParseTasks(json, expected));
+    for (size_t chunks : {1, 2, 3, 8, 64}) {
+        StringArena arena;
+        std::vector<Task> tasks;
+        ASSERT_TRUE(TaskList::ParseTasksParallel(json, tasks, chunks, true, &arena)) << chunks;
+        ASSERT_EQ(tasks.size(), expected.size()) << chunks;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            EXPECT_EQ(tasks[i].GetId(), expected[i].GetId());
+            EXPECT_EQ(tasks[i].GetDescription(), expected[i].GetDescription());
+            EXPECT_EQ(tasks[i].GetStatus(), expected[i].GetStatus());
+            EXPECT_TRUE(tasks[i].IsBorrowed());
+        }
+    }
+
+    std::vector<Task> tasks;
+    json.replace(json.find("\"id\": 41"), 8, "\"id\": \"x\"");
+    EXPECT_FALSE(TaskList::ParseTasksParallel(json, tasks, 4));
+}
+
+TEST_F(JsonParsingTest, SaveAsOverLoadedStoreKeepsDescriptions) {
+    CreateTestJsonFile(R"([
+    {"id": 1, "description": "plain", "status": "TODO",
+     "createdAt": "2025-08-02 23:30:00", "updatedAt": null},
+    {"id": 2, "description": "tab\there", "status": "DONE",
+     "createdAt": "2025-08-02 23:31:00", "updatedAt": null}
+])");
+    
+    TaskList tl(testJsonPath);
+    ASSERT_TRUE(tl.SaveAs(testJsonPath, TaskListOptions::Format::JSON));
+    ASSERT_NE(tl.FindById(1), nullptr);
+    ASSERT_NE(tl.FindById(2), nullptr);
+    EXPECT_EQ(tl.FindById(1)->GetDescription(), "plain");
+    EXPECT_EQ(tl.FindById(2)->GetDescription(), "tab\there");
+}
+
+TEST_F(JsonParsingTest, ParseTasksIgnoresUnknownKeys) {
+    std::string json = R"([
+    {
+        "id": 1,
+        "tags": ["a", {"nested": [1, 2]}],
+        "description": "Braces { } and [ ] inside strings",
+        "status": "TODO",
+        "priority": 3,
+        "createdAt": "2025-08-02 23:30:00",
+        "updatedAt": "null"
+    },
+    {"id": 2, "description": "Second", "status": "DONE",
+     "createdAt": "2025-08-02 23:31:00", "updatedAt": "2025-08-02 23:32:00"}
+])";
+    
+    std::vector<Task> tasks;
+    ASSERT_TRUE(TaskList::ParseTasks(json, tasks));
+    ASSERT_EQ(tasks.size(), 2);
+    EXPECT_EQ(tasks[0].GetDescription(), "Braces { } and [ ] inside strings");
+    EXPECT_EQ(tasks[1].GetId(), 2);
+    EXPECT_EQ(tasks[1].GetUpdatedAtString(), "2025-08-02 23:32:00");
+}
+
+TEST_F(JsonParsingTest, ParseTasksRejectsMalformedInput) {
+    std::vector<Task> tasks;
+    EXPECT_FALSE(TaskList::ParseTasks("", tasks));
+    EXPECT_FALSE(TaskList::ParseTasks("{}", tasks));
+    EXPECT_FALSE(TaskList::ParseTasks(R"([{"id": 1, "description": "unterminated)", tasks));
+    EXPECT_FALSE(TaskList::ParseTasks(R"([{"id": 1} {"id": 2}])", tasks));
+    EXPECT_FALSE(TaskList::ParseTasks(R"([{"id": "x1", "description": "d", "status": "TODO",
+        "createdAt": "2025-08-02 23:30:00", "updatedAt": "null"}])", tasks));
+    EXPECT_FALSE(TaskList::ParseTasks(R"([{"id": 1, "description": "bad \q escape"}])", tasks));
+} 
+TEST_F(JsonParsingTest, LoadedDescriptionsSurviveSave) {
+    std::string json = R"([
+    {
+        "id": 1,
+        "description": "Loaded Task",
+        "status": "TODO",
+        "createdAt": "2025-08-02 23:30:00",
+        "updatedAt": "null"
+    }
+])";
+    
+    CreateTestJsonFile(json);
+    {
+        TaskList tl(testJsonPath);
+        EXPECT_TRUE(tl.AddTask("Added Task"));
+    }
+    
+    TaskList tl(testJsonPath);
+    ASSERT_EQ(tl.Size(), 2);
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    EXPECT_EQ(todo[0].GetDescription(), "Loaded Task");
+    EXPECT_EQ(todo[1].GetDescription(), "Added Task");
+}
+
+// Writer Tests
+TEST_F(JsonParsingTest, WriteTasksRoundTripsEscapes) {
+    std::vector<Task> tasks;
+    tasks.emplace_back(1, "Quotes \"x\", backslash \\, slash /");
+    tasks.emplace_back(2, std::string("Control \n\t\r\b\f \x01 and ") + '\0' + " nul");
+    tasks.emplace_back(3, "Unicode: café 🚀");
+    tasks[1].MarkTask(Task::Status::DONE);
+    
+    ASSERT_TRUE(TaskList::WriteTasks(tasks, testJsonPath));
+    
+    std::ifstream in(testJsonPath);
+    std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_NE(json.find(R"(Quotes \"x\", backslash \\, slash /)"), std::string::npos);
+    EXPECT_NE(json.find(R"(Control \n\t\r\b\f \u0001 and \u0000 nul)"), std::string::npos);
+    
+    std::vector<Task> loaded;
+    ASSERT_TRUE(TaskList::ParseTasks(json, loaded));
+    ASSERT_EQ(loaded.size(), tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        EXPECT_EQ(loaded[i].GetId(), tasks[i].GetId());
+        EXPECT_EQ(loaded[i].GetDescription(), tasks[i].GetDescription());
+        EXPECT_EQ(loaded[i].GetStatus(), tasks[i].GetStatus());
+        EXPECT_EQ(loaded[i].GetCreatedAtString(), tasks[i].GetCreatedAtString());
+        EXPECT_EQ(loaded[i].GetUpdatedAtString(), tasks[i].GetUpdatedAtString());
+    }
+}
+
+TEST_F(JsonParsingTest, WriteTasksKeepsStoreLayout) {
+    std::string json = R"([
+    {
+        "id": 1,
+        "description": "First",
+        "status": "TODO",
+        "createdAt": "2025-08-02 23:30:00",
+        "updatedAt": "null"
+    },
+    {
+        "id": 2,
+        "description": "Second",
+        "status": "DONE",
+        "createdAt": "2025-08-02 23:31:00",
+        "updatedAt": "2025-08-02 23:32:00"
+    }
+]
+)";
+    
+    std::vector<Task> tasks;
+    ASSERT_TRUE(TaskList::ParseTasks(json, tasks));
+    ASSERT_TRUE(TaskList::WriteTasks(tasks, testJsonPath));
+    
+    std::ifstream in(testJsonPath);
+    std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(written, json);
+}
+
+TEST_F(JsonParsingTest, WriteTasksKeepsNextIdAboveTasks) {
+    std::vector<Task> tasks;
+    tasks.emplace_back(1, "First");
+    tasks.emplace_back(2, "Second");
+    auto read = [this] {
+        std::ifstream in(testJsonPath);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+    
+    // The next id after the tasks needs no object, the store stays an array
+    ASSERT_TRUE(TaskList::WriteTasks(tasks, testJsonPath, 1, false, 3));
+    EXPECT_TRUE(read().starts_with("[\n"));
+    
+    ASSERT_TRUE(TaskList::WriteTasks(tasks, testJsonPath, 1, false, 7));
+    std::string serial = read();
+    EXPECT_TRUE(serial.starts_with("{\"nextId\": 7, \"tasks\": [\n")) << serial;
+    ASSERT_TRUE(TaskList::WriteTasks(tasks, testJsonPath, 2, false, 7));
+    EXPECT_EQ(read(), serial);
+    
+    JsonReader reader{serial};
+    ASSERT_TRUE(reader.BeginArray());
+    EXPECT_EQ(reader.NextId(), "7");
+    std::vector<Task> loaded;
+    ASSERT_TRUE(TaskList::ParseTasks(serial, loaded));
+    ASSERT_EQ(loaded.size(), 2);
+    EXPECT_EQ(loaded[1].GetDescription(), "Second");
+    loaded.clear();
+    ASSERT_TRUE(TaskList::ParseTasksParallel(serial, loaded, 2));
+    EXPECT_EQ(loaded.size(), 2);
+}
+
+TEST_F(JsonParsingTest, WriteTasksInChunksMatchesOneThread) {
+    std::vector<Task> tasks;
+    for (int i = 1; i <= 10; ++i)
+        tasks.emplace_back(i, "Task \"" + std::to_string(i) + "\"");
+    tasks[3].MarkTask(Task::Status::DONE);
+    
+    ASSERT_TRUE(TaskList::WriteTasks(tasks, testJsonPath));
+    std::ifstream serialIn(testJsonPath);
+    std::string serial((std::istreambuf_iterator<char>(serialIn)), std::istreambuf_iterator<char>());
+    serialIn.close();
+    
+    // Also more threads than tasks
+    for (size_t threads : {2, 3, 10, 16}) {
+        ASSERT_TRUE(TaskList::WriteTasks(tasks, testJsonPath, threads));
+        std::ifstream in(testJsonPath);
+        std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(written, serial) << threads;
+    }
+    
+    // A shorter store over a longer one leaves nothing behind
+    tasks.erase(tasks.begin() + 2, tasks.end());
+    ASSERT_TRUE(TaskList::WriteTasks(tasks, testJsonPath, 2));
+    std::vector<Task> loaded;
+    std::ifstream in(testJsonPath);
+    ASSERT_TRUE(TaskList::ParseTasks(std::string((std::istreambuf_iterator<char>(in)), 
+        std::istreambuf_iterator<char>()), loaded));
+    EXPECT_EQ(loaded.size(), 2);
+}
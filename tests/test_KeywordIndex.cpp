@@ -0,0 +1,94 @@
+#include "../src/KeywordIndex.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class KeywordIndexTest : public ::testing::Test {
+protected:
+    KeywordIndex index;
+    
+    void SetUp() override {
+        index.Add(1, "Fix the parser crash");
+        index.Add(2, "Deploy parser service");
+        index.Add(3, "Write deployment docs");
+        index.Add(4, "Review PARSER-tests, then deploy!");
+    }
+};
+
+TEST_F(KeywordIndexTest, TokenizeLowercasesAndSplits) {
+    std::vector<std::string> terms;
+    KeywordIndex::Tokenize("  Fix-it: café #42 ", 
+        [&](std::string_view term) { terms.emplace_back(term); });
+    EXPECT_EQ(terms, (std::vector<std::string>{"fix", "it", "café", "42"}));
+}
+
+TEST_F(KeywordIndexTest, SingleTermIsCaseInsensitive) {
+    EXPECT_EQ(index.Query("parser"), (std::vector<int>{1, 2, 4}));
+    EXPECT_EQ(index.Query("PaRsEr"), (std::vector<int>{1, 2, 4}));
+    EXPECT_TRUE(index.Query("missing").empty());
+}
+
+TEST_F(KeywordIndexTest, TermsAreAnded) {
+    EXPECT_EQ(index.Query("parser deploy"), (std::vector<int>{2, 4}));
+    EXPECT_EQ(index.Query("parser AND fix"), (std::vector<int>{1}));
+    EXPECT_EQ(index.Query("parser-tests"), (std::vector<int>{4}));
+    EXPECT_TRUE(index.Query("parser docs").empty());
+}
+
+TEST_F(KeywordIndexTest, OrCombinesAlternatives) {
+    EXPECT_EQ(index.Query("docs OR crash"), (std::vector<int>{1, 3}));
+    EXPECT_EQ(index.Query("parser deploy OR docs"), (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(index.Query("OR docs OR"), (std::vector<int>{3}));
+}
+
+TEST_F(KeywordIndexTest, PrefixMatching) {
+    EXPECT_EQ(index.Query("deploy*"), (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(index.Query("dep* parser"), (std::vector<int>{2, 4}));
+    EXPECT_TRUE(index.Query("zz*").empty());
+}
+
+TEST_F(KeywordIndexTest, RemoveDropsIdAndEmptyTerms) {
+    size_t terms = index.TermCount();
+    index.Remove(3, "Write deployment docs");
+    EXPECT_TRUE(index.Query("docs").empty());
+    EXPECT_EQ(index.Query("deploy*"), (std::vector<int>{2, 4}));
+    EXPECT_EQ(index.TermCount(), terms - 3);
+    
+    // Re-adding out of order keeps the postings sorted
+    index.Add(3, "parser docs");
+    EXPECT_EQ(index.Query("parser"), (std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST_F(KeywordIndexTest, DuplicateTermsCountOnce) {
+    index.Add(5, "parser parser PARSER");
+    index.Remove(5, "parser parser PARSER");
+    EXPECT_EQ(index.Query("parser"), (std::vector<int>{1, 2, 4}));
+}
+
+TEST_F(KeywordIndexTest, MatcherAgreesWithQuery) {
+    const std::vector<std::pair<int, std::string>> texts = {
+        {1, "Fix the parser crash"}, {2, "Deploy parser service"},
+        {3, "Write deployment docs"}, {4, "Review PARSER-tests, then deploy!"}};
+    auto scan = [&](std::string_view fragment) {
+        std::vector<int> ids;
+        for (const auto& [id, text] : texts) {
+            KeywordIndex::Matcher matcher("*" + std::string(fragment) + "*");
+            if (matcher.Matches(text))
+                ids.push_back(id);
+        }
+        return ids;
+    };
+    for (const char* query : {"parser", "PARSER deploy", "deploy*", "parser-tests",
+        "fix OR docs", "deploy* AND parser OR write", "*ARSE*", "*ploy", "OR", "*", "missing"}) {
+        std::vector<int> matched;
+        KeywordIndex::Matcher matcher(query);
+        for (const auto& [id, text] : texts) {
+            if (matcher.Matches(text))
+                matched.push_back(id);
+        }
+        EXPECT_EQ(matched, index.Query(query, scan)) << query;
+    }
+    EXPECT_EQ(index.Query("*arse*"), std::vector<int>{});
+}
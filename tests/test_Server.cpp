@@ -0,0 +1,195 @@
+#include "../src/Server.h"
+#include <gtest/gtest.h>
+#include "TestUtil.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ServerTest : public ::testing::Test {
+protected:
+    std::filesystem::path testJsonPath;
+    std::filesystem::path socketPath;
+    std::optional<TaskList> tasks;
+    std::optional<TaskServer> server;
+    std::thread serverThread;
+    bool served = false;
+    
+    void SetUp() override {
+#ifdef _WIN32
+        GTEST_SKIP() << "Unix domain sockets only";
+#endif
+        testJsonPath = testutil::TempPath("test-task-tracker-server", ".json");
+        socketPath = testutil::TempPath("test-task-tracker-server", ".sock");
+        RemoveStore();
+        
+        TaskListOptions options;
+        options.persistence = TaskListOptions::Persistence::JOURNAL;
+        tasks.emplace(testJsonPath, options);
+        TaskServer::Options serverOptions;
+        serverOptions.socketPath = socketPath;
+        server.emplace(*tasks, serverOptions);
+        serverThread = std::thread([this] { served = server->Run(); });
+        ASSERT_TRUE(server->WaitReady());
+    }
+    
+    void TearDown() override {
+        if (!server)
+            return;
+        StopServer();
+        tasks.reset();
+        RemoveStore();
+    }
+    
+    void StopServer() {
+        if (serverThread.joinable()) {
+            server->Stop();
+            serverThread.join();
+        }
+    }
+    
+    void RemoveStore() {
+        testutil::RemoveStoreFiles(testJsonPath);
+    }
+    
+    std::string ReadStore() {
+        std::ifstream in(testJsonPath);
+        std::ostringstream oss;
+        oss << in.rdbuf();
+        return oss.str();
+    }
+};
+
+TEST_F(ServerTest, RunsCommands) {
+    TaskClient client;
+    ASSERT_TRUE(client.Connect(socketPath));
+    
+    auto response = client.Send("add \"Fix the \\\"parser\\\"\"");
+    ASSERT_TRUE(response);
+    EXPECT_TRUE(response->ok);
+    EXPECT_TRUE(response->output.empty());
+    
+    response = client.Send("search parser");
+    ASSERT_TRUE(response);
+    EXPECT_TRUE(response->ok);
+    EXPECT_NE(response->output.find("Fix the \"parser\""), std::string::npos);
+    
+    // Failures come back with the error text
+    response = client.Send("mark-done 42");
+    ASSERT_TRUE(response);
+    EXPECT_FALSE(response->ok);
+    EXPECT_NE(response->output.find("Could not mark task 42"), std::string::npos);
+    EXPECT_NE(response->output.find("Task with id 42 does not exist"), std::string::npos);
+    
+    response = client.Send("update 99 x");
+    ASSERT_TRUE(response);
+    EXPECT_FALSE(response->ok);
+    EXPECT_NE(response->output.find("Task with id 99 does not exist"), std::string::npos);
+    
+    // So do parse errors
+    response = client.Send("update abc x");
+    ASSERT_TRUE(response);
+    EXPECT_FALSE(response->ok);
+    EXPECT_NE(response->output.find("abc is not a valid positive integer"), std::string::npos);
+    response = client.Send("add \"unterminated");
+    ASSERT_TRUE(response);
+    EXPECT_FALSE(response->ok);
+    EXPECT_NE(response->output.find("unterminated quote"), std::string::npos);
+    
+    response = client.Send("serve");
+    ASSERT_TRUE(response);
+    EXPECT_FALSE(response->ok);
+    
+    response = client.Send("mark-done 1");
+    ASSERT_TRUE(response);
+    EXPECT_TRUE(response->ok);
+    EXPECT_EQ(tasks->CountByStatus(Task::Status::DONE), 1);
+}
+
+TEST_F(ServerTest, SecondServerIsRefused) {
+    TaskServer::Options options;
+    options.socketPath = socketPath;
+    TaskServer second(*tasks, options);
+    EXPECT_FALSE(second.Run());
+    EXPECT_FALSE(second.WaitReady());
+}
+
+TEST_F(ServerTest, ConcurrentClients) {
+    constexpr int CLIENTS = 4;
+    constexpr int ADDS = 50;
+    std::vector<std::thread> clients;
+    std::atomic<int> failures{0};
+    for (int c = 0; c < CLIENTS; ++c) {
+        clients.emplace_back([&, c] {
+            TaskClient client;
+            if (!client.Connect(socketPath)) {
+                ++failures;
+                return;
+            }
+            for (int i = 0; i < ADDS; ++i) {
+                auto added = client.Send("add \"Client " + std::to_string(c) + " task\"");
+                auto listed = client.Send("list todo");
+                if (!added || !added->ok || !listed || !listed->ok)
+                    ++failures;
+            }
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    EXPECT_EQ(failures, 0);
+    EXPECT_EQ(tasks->Size(), CLIENTS * ADDS);
+}
+
+TEST_F(ServerTest, FlushesOnDemandAndOnStop) {
+    TaskClient client;
+    ASSERT_TRUE(client.Connect(socketPath));
+    ASSERT_TRUE(client.Send("add \"First task\"")->ok);
+    EXPECT_EQ(ReadStore().find("First task"), std::string::npos);
+    
+    ASSERT_TRUE(client.Send("flush")->ok);
+    EXPECT_NE(ReadStore().find("First task"), std::string::npos);
+    
+    // Stopping closes open connections and writes what is left
+    ASSERT_TRUE(client.Send("add \"Second task\"")->ok);
+    StopServer();
+    EXPECT_TRUE(served);
+    EXPECT_FALSE(client.Send("list"));
+    EXPECT_NE(ReadStore().find("Second task"), std::string::npos);
+    EXPECT_FALSE(std::filesystem::exists(socketPath));
+}
+
+TEST_F(ServerTest, ClientOnlyConnectsToSockets) {
+    // A regular file where the socket should be is never taken for a server
+    const auto path = testutil::TempPath("test-task-tracker-server-file", ".sock");
+    std::ofstream(path) << "not a socket";
+    TaskClient client;
+    EXPECT_FALSE(client.Connect(path));
+    std::filesystem::remove(path);
+}
+
+TEST_F(ServerTest, CreatesPrivateSocketDirectory) {
+    StopServer();
+    const auto dir = testutil::TempPath("test-task-tracker-server-dir", "");
+    std::filesystem::remove_all(dir);
+    TaskServer::Options options;
+    options.socketPath = dir / "task-tracker.sock";
+    TaskServer second(*tasks, options);
+    std::thread thread([&] { second.Run(); });
+    ASSERT_TRUE(second.WaitReady());
+    auto perms = std::filesystem::status(dir).permissions();
+    EXPECT_EQ(perms, std::filesystem::perms::owner_all);
+    perms = std::filesystem::symlink_status(options.socketPath).permissions();
+    EXPECT_EQ(perms, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+
+    TaskClient client;
+    ASSERT_TRUE(client.Connect(options.socketPath));
+    EXPECT_TRUE(client.Send("list")->ok);
+    second.Stop();
+    thread.join();
+    std::filesystem::remove_all(dir);
+}
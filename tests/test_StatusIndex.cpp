@@ -0,0 +1,104 @@
+#include "../src/StatusIndex.h"
+#include <gtest/gtest.h>
+#include <optional>
+#include <random>
+#include <vector>
+
+// Compares against a plain vector of statuses after random operations,
+// removed slots are nullopt
+class StatusIndexTest : public ::testing::Test {
+protected:
+    StatusIndex index;
+    std::vector<std::optional<Task::Status>> model;
+    
+    void ExpectMatchesModel() {
+        ASSERT_EQ(index.Size(), model.size());
+        for (auto status : {Task::Status::TODO, Task::Status::IN_PROGRESS, Task::Status::DONE}) {
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < model.size(); ++i) {
+                if (model[i] == status) expected.push_back(i);
+            }
+            std::vector<size_t> actual;
+            index.ForEach(status, 0, model.size(), [&](size_t i) { actual.push_back(i); });
+            ASSERT_EQ(actual, expected);
+            ASSERT_EQ(index.Count(status), expected.size());
+        }
+        for (size_t i = 0; i < model.size(); ++i) {
+            ASSERT_EQ(index.IsLive(i), model[i].has_value());
+        }
+    }
+};
+
+TEST_F(StatusIndexTest, RandomOperationsMatchModel) {
+    std::mt19937 rng{3};
+    for (int step = 0; step < 3000; ++step) {
+        auto status = static_cast<Task::Status>(rng() % 3);
+        switch (rng() % 4) {
+            case 0:
+            case 1:
+                index.PushBack(status);
+                model.push_back(status);
+                break;
+            case 2:
+                if (!model.empty()) {
+                    size_t pos = rng() % model.size();
+                    if (model[pos]) {
+                        index.Set(pos, *model[pos], status);
+                        model[pos] = status;
+                    }
+                }
+                break;
+            case 3:
+                if (!model.empty()) {
+                    size_t pos = rng() % model.size();
+                    if (model[pos]) {
+                        index.Remove(pos, *model[pos]);
+                        model[pos].reset();
+                    }
+                }
+                break;
+        }
+        if (step % 100 == 0) ExpectMatchesModel();
+    }
+    ExpectMatchesModel();
+}
+
+TEST_F(StatusIndexTest, RemoveKeepsPositions) {
+    for (int i = 0; i < 130; ++i) {
+        auto status = i % 64 == 63 ? Task::Status::DONE : Task::Status::TODO;
+        index.PushBack(status);
+        model.push_back(status);
+    }
+    index.Remove(63, Task::Status::DONE);
+    model[63].reset();
+    ExpectMatchesModel();
+    EXPECT_EQ(index.Size(), 130);
+    
+    // Removing twice or with the wrong status changes nothing
+    index.Remove(63, Task::Status::DONE);
+    index.Remove(0, Task::Status::DONE);
+    ExpectMatchesModel();
+    
+    // Appending after a removed slot
+    index.PushBack(Task::Status::IN_PROGRESS);
+    model.push_back(Task::Status::IN_PROGRESS);
+    ExpectMatchesModel();
+}
+
+TEST_F(StatusIndexTest, ForEachHonoursRange) {
+    std::vector<Task> tasks;
+    for (int i = 0; i < 200; ++i) {
+        tasks.emplace_back(i + 1, "Task");
+    }
+    index.Assign(tasks);
+    
+    std::vector<size_t> seen;
+    index.ForEach(Task::Status::TODO, 62, 130, [&](size_t i) { seen.push_back(i); });
+    ASSERT_EQ(seen.size(), 68);
+    EXPECT_EQ(seen.front(), 62);
+    EXPECT_EQ(seen.back(), 129);
+    
+    seen.clear();
+    index.ForEach(Task::Status::TODO, 128, 128, [&](size_t i) { seen.push_back(i); });
+    EXPECT_TRUE(seen.empty());
+}
@@ -0,0 +1,28 @@
+#include "../src/StringArena.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+TEST(StringArenaTest, CopiesOutliveTheirSource) {
+    StringArena arena;
+    std::vector<std::string_view> copies;
+    for (int i = 0; i < 10000; ++i) {
+        std::string source = "description number " + std::to_string(i);
+        copies.push_back(arena.Copy(source));
+    }
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(copies[i], "description number " + std::to_string(i));
+    }
+    EXPECT_TRUE(arena.Copy("").empty());
+}
+
+TEST(StringArenaTest, ReleaseResetsUsage) {
+    StringArena arena;
+    arena.Copy("first");
+    arena.Copy("second");
+    EXPECT_EQ(arena.BytesUsed(), 11);
+    
+    arena.Release();
+    EXPECT_EQ(arena.BytesUsed(), 0);
+    EXPECT_EQ(arena.Copy("third"), "third");
+}
@@ -0,0 +1,96 @@
+#include "../src/SubstringScan.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using SubstringScan::Isa;
+
+class SubstringScanTest : public ::testing::TestWithParam<Isa> {
+protected:
+    void SetUp() override {
+        if (GetParam() > SubstringScan::Detected()) {
+            GTEST_SKIP() << "Instruction set not supported on this CPU";
+        }
+    }
+    
+    static size_t Reference(std::string haystack, std::string needle, bool ignoreCase) {
+        if (ignoreCase) {
+            auto lower = [](char c) { return (c >= 'A' && c <= 'Z') ? char(c + 32) : c; };
+            std::transform(haystack.begin(), haystack.end(), haystack.begin(), lower);
+            std::transform(needle.begin(), needle.end(), needle.begin(), lower);
+        }
+        return haystack.find(needle);
+    }
+};
+
+TEST_P(SubstringScanTest, FindsAtEveryOffset) {
+    std::string haystack(100, 'x');
+    for (size_t n = 1; n <= 40; ++n) {
+        std::string needle(n, 'y');
+        needle.front() = 'a';
+        needle.back() = 'b';
+        for (size_t pos = 0; pos + n <= haystack.size(); ++pos) {
+            std::string text = haystack;
+            text.replace(pos, n, needle);
+            ASSERT_EQ(SubstringScan::Find(text, needle, false, GetParam()), pos) 
+                << "n=" << n << " pos=" << pos;
+        }
+    }
+}
+
+TEST_P(SubstringScanTest, MatchesStdFind) {
+    std::mt19937 rng{7};
+    const std::string alphabet = "abAB c";
+    for (int round = 0; round < 2000; ++round) {
+        std::string haystack(rng() % 200, ' ');
+        for (auto& c : haystack) c = alphabet[rng() % alphabet.size()];
+        std::string needle(1 + rng() % 6, ' ');
+        for (auto& c : needle) c = alphabet[rng() % alphabet.size()];
+        
+        for (bool ignoreCase : {false, true}) {
+            ASSERT_EQ(SubstringScan::Find(haystack, needle, ignoreCase, GetParam()),
+                Reference(haystack, needle, ignoreCase))
+                << "'" << haystack << "' / '" << needle << "' ignoreCase=" << ignoreCase;
+        }
+    }
+}
+
+TEST_P(SubstringScanTest, CaseFoldingIsAsciiOnly) {
+    EXPECT_EQ(SubstringScan::Find("Deploy the PARSER now", "parser", true, GetParam()), 11);
+    EXPECT_EQ(SubstringScan::Find("Deploy the PARSER now", "parser", false, GetParam()),
+        std::string_view::npos);
+    // '@' and '[' border 'A' and 'Z' and must not fold onto '`' and '{'
+    EXPECT_EQ(SubstringScan::Find("@[ `{", "`{", true, GetParam()), 3);
+    EXPECT_EQ(SubstringScan::Find("CAFÉ", "café", true, GetParam()), std::string_view::npos);
+}
+
+TEST_P(SubstringScanTest, CorpusReportsEachTextOnce) {
+    SubstringScan::Corpus corpus;
+    corpus.Add("Fix the Parser");
+    corpus.Add("parser parser parser");
+    corpus.Add("unrelated");
+    corpus.Add("pars");
+    corpus.Add("er at the start");
+    corpus.Add("");
+    corpus.Add("ends in PARSER");
+    
+    std::vector<size_t> hits;
+    corpus.FindAll("parser", true, [&](size_t i) { hits.push_back(i); }, GetParam());
+    EXPECT_EQ(hits, (std::vector<size_t>{0, 1, 6}));
+    
+    hits.clear();
+    corpus.FindAll("parser", false, [&](size_t i) { hits.push_back(i); }, GetParam());
+    EXPECT_EQ(hits, (std::vector<size_t>{1}));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, SubstringScanTest,
+    ::testing::Values(Isa::SCALAR, Isa::SSE2, Isa::AVX2),
+    [](const ::testing::TestParamInfo<Isa>& info) {
+        switch (info.param) {
+            case Isa::SCALAR: return "Scalar";
+            case Isa::SSE2: return "Sse2";
+            default: return "Avx2";
+        }
+    });
@@ -239,3 +239,45 @@ TEST_F(TaskTest, TaskWithNegativeId)
     Task task(-1, "Test Task");
     EXPECT_EQ(task.GetId(), -1);
 }
+
+// Borrowed Description Tests
+TEST_F(TaskTest, BorrowingDoesNotCopyDescription)
+{
+    std::string storage = "Borrowed Task";
+    auto now = std::chrono::system_clock::now();
+    Task task = Task::Borrowing(1, storage, Task::Status::TODO, now, std::nullopt);
+    
+    EXPECT_TRUE(task.IsBorrowed());
+    EXPECT_EQ(task.GetDescription().data(), storage.data());
+    EXPECT_EQ(task.GetDescription(), "Borrowed Task");
+}
+
+TEST_F(TaskTest, CopyDetachesBorrowedDescription)
+{
+    std::string storage = "Borrowed Task";
+    auto now = std::chrono::system_clock::now();
+    Task task = Task::Borrowing(1, storage, Task::Status::TODO, now, std::nullopt);
+    
+    Task copy = task;
+    EXPECT_FALSE(copy.IsBorrowed());
+    EXPECT_NE(copy.GetDescription().data(), storage.data());
+    EXPECT_EQ(copy.GetDescription(), "Borrowed Task");
+    
+    Task moved = std::move(task);
+    EXPECT_TRUE(moved.IsBorrowed());
+}
+
+TEST_F(TaskTest, UpdateDetachesBorrowedDescription)
+{
+    std::string storage = "Borrowed Task";
+    auto now = std::chrono::system_clock::now();
+    Task task = Task::Borrowing(1, storage, Task::Status::TODO, now, std::nullopt);
+    
+    task.MarkTask(Task::Status::DONE);
+    EXPECT_TRUE(task.IsBorrowed());
+    
+    EXPECT_TRUE(task.UpdateTask("New Description"));
+    EXPECT_FALSE(task.IsBorrowed());
+    EXPECT_EQ(task.GetDescription(), "New Description");
+    EXPECT_EQ(storage, "Borrowed Task");
+}
@@ -0,0 +1,29 @@
+#include "../src/TaskColumns.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(TaskColumnsTest, MirrorsTaskFields) {
+    using namespace std::chrono;
+    const system_clock::time_point created{seconds{1'700'000'000}};
+    std::vector<Task> tasks;
+    tasks.emplace_back(4, "first", Task::Status::TODO, created, std::nullopt);
+    tasks.emplace_back(9, "second", Task::Status::DONE, created + hours{1}, created + hours{2});
+    
+    TaskColumns columns;
+    columns.Assign(tasks);
+    ASSERT_EQ(columns.Size(), 2);
+    EXPECT_EQ(columns.Ids()[0], 4);
+    EXPECT_EQ(columns.Ids()[1], 9);
+    EXPECT_EQ(columns.CreatedAt()[1], TaskColumns::ToRep(created + hours{1}));
+    EXPECT_EQ(columns.UpdatedAt()[0], TaskColumns::NEVER);
+    EXPECT_EQ(columns.UpdatedAt()[1], TaskColumns::ToRep(created + hours{2}));
+    
+    tasks[0].MarkTask(Task::Status::DONE, created + hours{3});
+    columns.Set(0, tasks[0]);
+    EXPECT_EQ(columns.UpdatedAt()[0], TaskColumns::ToRep(created + hours{3}));
+    
+    columns.PushBack(Task(12, "third"));
+    ASSERT_EQ(columns.Size(), 3);
+    EXPECT_EQ(columns.Ids()[2], 12);
+    EXPECT_EQ(columns.UpdatedAt()[2], TaskColumns::NEVER);
+}
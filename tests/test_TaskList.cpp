@@ -2,10 +2,18 @@
 
 #include "../src/TaskList.h"
 #include <gtest/gtest.h>
+#include "TestUtil.h"
 #include <fstream>
 #include <filesystem>
+#include <ranges>
+#include <set>
 #include <sstream>
 
+#ifndef _WIN32
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
 class TaskListTest : public ::testing::Test {
 protected:
     std::filesystem::path testJsonPath;
@@ -13,8 +21,8 @@ protected:
     
     void SetUp() override {
         // Create temporary test files
-        testJsonPath = std::filesystem::temp_directory_path() / "test-task-tracker.json";
-        testJsonTmpPath = std::filesystem::temp_directory_path() / "test-task-tracker.json.tmp";
+        testJsonPath = testutil::TempPath("test-task-tracker", ".json");
+        testJsonTmpPath = testJsonPath.string() + ".tmp";
         
         // Clean up any existing test files
         if (std::filesystem::exists(testJsonPath)) {
@@ -33,6 +41,10 @@ protected:
         if (std::filesystem::exists(testJsonTmpPath)) {
             std::filesystem::remove(testJsonTmpPath);
         }
+        for (const char* suffix : {".journal", ".lock"}) {
+            auto path = testJsonPath;
+            std::filesystem::remove(path += suffix);
+        }
     }
     
     void CreateTestJsonFile(const std::string& content) {
@@ -53,11 +65,12 @@ protected:
 TEST_F(TaskListTest, EmptyTaskList) {
     CreateTestJsonFile("[]");
     
-    // Not possible without file path dependency.
+    TaskList tl(testJsonPath);
+    EXPECT_EQ(tl.Size(), 0);
 }
 
 TEST_F(TaskListTest, AddTask) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     
     size_t initialSize = tl.Size();
     bool result = tl.AddTask("Test Task");
@@ -67,14 +80,14 @@ TEST_F(TaskListTest, AddTask) {
 }
 
 TEST_F(TaskListTest, AddTaskWithEmptyDescription) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     
     bool result = tl.AddTask("");
     EXPECT_FALSE(result);
 }
 
 TEST_F(TaskListTest, AddTaskWithVeryLongDescription) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     std::string longDesc(1001, 'a'); // More than 1000 characters
     
     bool result = tl.AddTask(longDesc);
@@ -82,7 +95,7 @@ TEST_F(TaskListTest, AddTaskWithVeryLongDescription) {
 }
 
 TEST_F(TaskListTest, AddMultipleTasks) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     size_t old_size = tl.Size();
     EXPECT_TRUE(tl.AddTask("Task 1"));
     EXPECT_TRUE(tl.AddTask("Task 2"));
@@ -93,15 +106,15 @@ TEST_F(TaskListTest, AddMultipleTasks) {
 
 // Update Tests
 TEST_F(TaskListTest, UpdateTaskValidIndex) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Original Description");
     
-    bool result = tl.UpdateTask(0, "Updated Description");
+    bool result = tl.UpdateTask(1, "Updated Description");
     EXPECT_TRUE(result);
 }
 
 TEST_F(TaskListTest, UpdateTaskInvalidIndex) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
     bool result = tl.UpdateTask(999, "Updated Description");
@@ -109,15 +122,15 @@ TEST_F(TaskListTest, UpdateTaskInvalidIndex) {
 }
 
 TEST_F(TaskListTest, UpdateTaskEmptyDescription) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Original Description");
     
-    bool result = tl.UpdateTask(0, "");
+    bool result = tl.UpdateTask(1, "");
     EXPECT_FALSE(result);
 }
 
 TEST_F(TaskListTest, UpdateTaskOutOfBounds) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
     bool result = tl.UpdateTask(-1, "Updated Description");
@@ -126,19 +139,19 @@ TEST_F(TaskListTest, UpdateTaskOutOfBounds) {
 
 // Remove Tests
 TEST_F(TaskListTest, RemoveTaskValidIndex) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Task 1");
     tl.AddTask("Task 2");
     
     size_t initialSize = tl.Size();
-    bool result = tl.RemoveTask(0);
+    bool result = tl.RemoveTask(1);
     
     EXPECT_TRUE(result);
     EXPECT_EQ(tl.Size(), initialSize - 1);
 }
 
 TEST_F(TaskListTest, RemoveTaskInvalidIndex) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
     bool result = tl.RemoveTask(999);
@@ -146,16 +159,62 @@ TEST_F(TaskListTest, RemoveTaskInvalidIndex) {
 }
 // Not possible as expected with current architecture
 TEST_F(TaskListTest, RemoveTaskOutOfBounds) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
     bool result = tl.RemoveTask(tl.Size()+1);
     EXPECT_FALSE(result);
 }
 
+TEST_F(TaskListTest, RemoveTaskKeepsOtherIds) {
+    TaskList tl(testJsonPath);
+    tl.AddTask("Task 1");
+    tl.AddTask("Task 2");
+    tl.AddTask("Task 3");
+    
+    // Tasks are addressed by id, not by position
+    EXPECT_TRUE(tl.RemoveTask(2));
+    EXPECT_FALSE(tl.RemoveTask(2));
+    EXPECT_FALSE(tl.MarkTask(2, Task::Status::DONE));
+    EXPECT_TRUE(tl.MarkTask(3, Task::Status::DONE));
+    EXPECT_TRUE(tl.UpdateTask(1, "Task 1 updated"));
+    
+    // Ids are not reused and the listing order is kept
+    tl.AddTask("Task 4");
+    auto all = tl.Select({});
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all[0].GetDescription(), "Task 1 updated");
+    EXPECT_EQ(all[1].GetId(), 3);
+    EXPECT_EQ(all[1].GetStatus(), Task::Status::DONE);
+    EXPECT_EQ(all[2].GetId(), 4);
+}
+
+TEST_F(TaskListTest, RemoveManyTasksCompacts) {
+    TaskList tl(testJsonPath);
+    for (int i = 0; i < 1000; ++i) {
+        tl.AddTask("Task " + std::to_string(i + 1));
+    }
+    for (int id = 1; id <= 1000; id += 2) {
+        ASSERT_TRUE(tl.RemoveTask(id));
+    }
+    EXPECT_EQ(tl.Size(), 500);
+    EXPECT_EQ(tl.CountByStatus(Task::Status::TODO), 500);
+    
+    // Every remaining id still resolves to its own task
+    for (int id = 2; id <= 1000; id += 2) {
+        ASSERT_TRUE(tl.MarkTask(id, Task::Status::DONE));
+    }
+    auto done = tl.GetByStatus(Task::Status::DONE);
+    ASSERT_EQ(done.size(), 500);
+    EXPECT_EQ(done[0].GetId(), 2);
+    EXPECT_EQ(done[499].GetDescription(), "Task 1000");
+    EXPECT_EQ(tl.FindByKeyWord("999").size(), 0);
+    EXPECT_EQ(tl.FindByKeyWord("1000").size(), 1);
+}
+
 // Not possible with current architecture
 //TEST_F(TaskListTest, RemoveTaskFromEmptyList) {
-//    TaskList tl;
+//    TaskList tl(testJsonPath);
 //    
 //    bool result = tl.RemoveTask(0);
 //    EXPECT_FALSE(result);
@@ -163,15 +222,15 @@ TEST_F(TaskListTest, RemoveTaskOutOfBounds) {
 
 // Mark Task Tests
 TEST_F(TaskListTest, MarkTaskValidIndex) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
-    bool result = tl.MarkTask(0, Task::Status::IN_PROGRESS);
+    bool result = tl.MarkTask(1, Task::Status::IN_PROGRESS);
     EXPECT_TRUE(result);
 }
 
 TEST_F(TaskListTest, MarkTaskInvalidIndex) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
     bool result = tl.MarkTask(999, Task::Status::DONE);
@@ -179,25 +238,25 @@ TEST_F(TaskListTest, MarkTaskInvalidIndex) {
 }
 
 TEST_F(TaskListTest, MarkTaskAllStatuses) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
-    EXPECT_TRUE(tl.MarkTask(0, Task::Status::TODO));
-    EXPECT_TRUE(tl.MarkTask(0, Task::Status::IN_PROGRESS));
-    EXPECT_TRUE(tl.MarkTask(0, Task::Status::DONE));
+    EXPECT_TRUE(tl.MarkTask(1, Task::Status::TODO));
+    EXPECT_TRUE(tl.MarkTask(1, Task::Status::IN_PROGRESS));
+    EXPECT_TRUE(tl.MarkTask(1, Task::Status::DONE));
 }
 
 // GetByStatus Tests
 TEST_F(TaskListTest, GetByStatus) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Task 1");
     tl.AddTask("Task 2");
     tl.AddTask("Task 3");
     
     // Mark some tasks with different statuses
-    tl.MarkTask(0, Task::Status::TODO);
-    tl.MarkTask(1, Task::Status::IN_PROGRESS);
-    tl.MarkTask(2, Task::Status::DONE);
+    tl.MarkTask(1, Task::Status::TODO);
+    tl.MarkTask(2, Task::Status::IN_PROGRESS);
+    tl.MarkTask(3, Task::Status::DONE);
     
     auto todoTasks = tl.GetByStatus(Task::Status::TODO);
     auto inProgressTasks = tl.GetByStatus(Task::Status::IN_PROGRESS);
@@ -212,10 +271,257 @@ TEST_F(TaskListTest, GetByStatus) {
     EXPECT_EQ(doneTasks[0].GetStatus(), Task::Status::DONE);
 }
 
+TEST_F(TaskListTest, GetByStatusReturnsViews) {
+    static_assert(std::ranges::random_access_range<TaskView>);
+    
+    TaskList tl(testJsonPath);
+    tl.AddTask("Task 1");
+    tl.AddTask("Task 2");
+    
+    // No copies, the view points at the tasks in the list
+    auto todo = tl.GetByStatus(Task::Status::TODO);
+    ASSERT_EQ(todo.size(), 2);
+    EXPECT_EQ(&todo[0], &tl.GetByStatus(Task::Status::TODO)[0]);
+    EXPECT_EQ(&todo[1], &*(todo.begin() + 1));
+}
+
+TEST_F(TaskListTest, SelectComposesFilters) {
+    TaskList tl(testJsonPath);
+    tl.AddTask("Fix parser crash");
+    tl.AddTask("Deploy parser service");
+    tl.AddTask("Write parser docs");
+    tl.AddTask("Write docs");
+    tl.MarkTask(2, Task::Status::DONE);
+    
+    TaskFilter filter;
+    filter.keywords = "parser";
+    filter.status = Task::Status::TODO;
+    auto view = tl.Select(filter);
+    ASSERT_EQ(view.size(), 2);
+    EXPECT_EQ(view[0].GetDescription(), "Fix parser crash");
+    EXPECT_EQ(view[1].GetDescription(), "Write parser docs");
+    
+    filter.minId = 2;
+    filter.maxId = 3;
+    view = tl.Select(filter);
+    ASSERT_EQ(view.size(), 1);
+    EXPECT_EQ(view[0].GetId(), 3);
+    
+    TaskFilter range;
+    range.minId = 2;
+    EXPECT_EQ(tl.Select(range).size(), 3);
+    range.maxId = 1;
+    EXPECT_TRUE(tl.Select(range).empty());
+    EXPECT_EQ(tl.Select({}).size(), 4);
+}
+
+TEST_F(TaskListTest, SelectByTimeRange) {
+    CreateTestJsonFile(R"([
+        {"id": 1, "description": "Old", "status": "TODO", "createdAt": "2025-01-10 10:00:00", "updatedAt": "null"},
+        {"id": 2, "description": "Middle", "status": "DONE", "createdAt": "2025-03-10 10:00:00", "updatedAt": "2025-04-01 08:00:00"},
+        {"id": 3, "description": "New", "status": "TODO", "createdAt": "2025-06-10 10:00:00", "updatedAt": "2025-06-11 08:00:00"}
+    ])");
+    TaskList tl(testJsonPath);
+    auto at = [](int month) {
+        return std::chrono::sys_days{std::chrono::year{2025} / month / 1};
+    };
+    
+    TaskFilter created;
+    created.createdFrom = at(2);
+    created.createdTo = at(7);
+    auto view = tl.Select(created);
+    ASSERT_EQ(view.size(), 2);
+    EXPECT_EQ(view[0].GetId(), 2);
+    EXPECT_EQ(view[1].GetId(), 3);
+    created.status = Task::Status::TODO;
+    ASSERT_EQ(tl.Select(created).size(), 1);
+    
+    // Never updated tasks only match an unbounded updatedAt range
+    TaskFilter updated;
+    updated.updatedTo = at(5);
+    view = tl.Select(updated);
+    ASSERT_EQ(view.size(), 1);
+    EXPECT_EQ(view[0].GetId(), 2);
+    
+    // Changes move a task into the range of recent updates
+    ASSERT_TRUE(tl.MarkTask(1, Task::Status::IN_PROGRESS));
+    updated = {};
+    updated.updatedFrom = at(7);
+    view = tl.Select(updated);
+    ASSERT_EQ(view.size(), 1);
+    EXPECT_EQ(view[0].GetId(), 1);
+    ASSERT_TRUE(tl.RemoveTask(1));
+    EXPECT_TRUE(tl.Select(updated).empty());
+}
+
+TEST_F(TaskListTest, SelectSortsAndPages) {
+    CreateTestJsonFile(R"([
+        {"id": 1, "description": "A", "status": "TODO", "createdAt": "2025-03-01 10:00:00", "updatedAt": "2025-05-01 08:00:00"},
+        {"id": 2, "description": "B", "status": "DONE", "createdAt": "2025-01-01 10:00:00", "updatedAt": "null"},
+        {"id": 3, "description": "C", "status": "TODO", "createdAt": "2025-02-01 10:00:00", "updatedAt": "2025-06-01 08:00:00"},
+        {"id": 4, "description": "D", "status": "TODO", "createdAt": "2025-04-01 10:00:00", "updatedAt": "null"}
+    ])");
+    TaskList tl(testJsonPath);
+    auto ids = [](const TaskView& view) {
+        std::vector<int> out;
+        for (const Task& task : view)
+            out.push_back(task.GetId());
+        return out;
+    };
+    
+    TaskOrder order;
+    order.key = TaskOrder::Key::CREATED;
+    EXPECT_EQ(ids(tl.Select({}, order)), (std::vector<int>{2, 3, 1, 4}));
+    order.descending = true;
+    order.limit = 2;
+    EXPECT_EQ(ids(tl.Select({}, order)), (std::vector<int>{4, 1}));
+    order.offset = 3;
+    EXPECT_EQ(ids(tl.Select({}, order)), (std::vector<int>{2}));
+    order.offset = 10;
+    EXPECT_TRUE(tl.Select({}, order).empty());
+    
+    // Never updated tasks come last, in list order
+    order = {};
+    order.key = TaskOrder::Key::UPDATED;
+    order.descending = true;
+    EXPECT_EQ(ids(tl.Select({}, order)), (std::vector<int>{3, 1, 2, 4}));
+    
+    TaskFilter todo;
+    todo.status = Task::Status::TODO;
+    order = {};
+    order.key = TaskOrder::Key::ID;
+    order.descending = true;
+    order.offset = 1;
+    EXPECT_EQ(ids(tl.Select(todo, order)), (std::vector<int>{3, 1}));
+    order.descending = false;
+    order.limit = 1;
+    EXPECT_EQ(ids(tl.Select(todo, order)), (std::vector<int>{3}));
+}
+
+TEST_F(TaskListTest, OnlyChangedListsAreSaved) {
+    {
+        TaskList tl(testJsonPath);
+        EXPECT_FALSE(tl.IsDirty());
+        ASSERT_TRUE(tl.AddTask("Task 1"));
+        EXPECT_TRUE(tl.IsDirty());
+        ASSERT_TRUE(tl.Flush());
+        EXPECT_FALSE(tl.IsDirty());
+    }
+    auto stamp = FileStamp::Of(testJsonPath);
+    ASSERT_TRUE(stamp.has_value());
+    {
+        TaskList tl(testJsonPath);
+        EXPECT_EQ(tl.Size(), 1);
+        EXPECT_FALSE(tl.MarkTask(7, Task::Status::DONE));
+        EXPECT_FALSE(tl.IsDirty());
+    }
+    EXPECT_EQ(FileStamp::Of(testJsonPath), stamp);
+    
+    {
+        TaskList tl(testJsonPath);
+        ASSERT_TRUE(tl.MarkTask(1, Task::Status::DONE));
+    }
+    EXPECT_NE(FileStamp::Of(testJsonPath), stamp);
+    TaskList tl(testJsonPath);
+    EXPECT_EQ(tl.CountByStatus(Task::Status::DONE), 1);
+}
+
+TEST_F(TaskListTest, RemovingEveryTaskIsSaved) {
+    {
+        TaskList tl(testJsonPath);
+        ASSERT_TRUE(tl.AddTask("Task 1"));
+        ASSERT_TRUE(tl.AddTask("Task 2"));
+    }
+    {
+        TaskList tl(testJsonPath);
+        ASSERT_EQ(tl.Size(), 2);
+        ASSERT_TRUE(tl.RemoveTask(1));
+        ASSERT_TRUE(tl.RemoveTask(2));
+        EXPECT_TRUE(tl.IsDirty());
+    }
+    TaskList tl(testJsonPath);
+    EXPECT_EQ(tl.Size(), 0);
+}
+
+TEST_F(TaskListTest, LazyLoadDecodesOnAccess) {
+    const std::string store = R"([
+        {"id": 1, "description": "First", "status": "TODO", "createdAt": "2025-01-10 10:00:00", "updatedAt": "null"},
+        {"id": 2, "description": "Say \"hi\"", "status": "DONE", "createdAt": "2025-03-10 10:00:00", "updatedAt": "2025-04-01 08:00:00"},
+        {"id": 3, "description": "Third", "status": "IN_PROGRESS", "createdAt": "2025-06-10 10:00:00", "updatedAt": "null"},
+        {"id": 4, "description": "Fourth", "status": "TODO", "createdAt": "2025-07-10 10:00:00", "updatedAt": "2025-07-11 10:00:00"}
+    ])";
+    CreateTestJsonFile(store);
+    std::vector<Task> expected;
+    ASSERT_TRUE(TaskList::ParseTasks(store, expected));
+    
+    TaskListOptions lazy;
+    lazy.lazy = true;
+    for (auto persistence : {TaskListOptions::Persistence::REWRITE, TaskListOptions::Persistence::JOURNAL}) {
+        CreateTestJsonFile(store);
+        lazy.persistence = persistence;
+        lazy.journalCompactBytes = 0;
+        {
+            TaskList tl(testJsonPath, lazy);
+            EXPECT_EQ(tl.Size(), 4);
+            EXPECT_EQ(tl.CountByStatus(Task::Status::DONE), 1);
+            ASSERT_TRUE(tl.MarkTask(3, Task::Status::DONE));
+            ASSERT_TRUE(tl.RemoveTask(1));
+            const Task* task = tl.FindById(2);
+            ASSERT_NE(task, nullptr);
+            EXPECT_EQ(task->GetDescription(), "Say \"hi\"");
+            EXPECT_EQ(task->GetUpdatedAt(), expected[1].GetUpdatedAt());
+        }
+        
+        // Untouched tasks are saved as they were loaded
+        TaskList tl(testJsonPath);
+        ASSERT_EQ(tl.Size(), 3);
+        EXPECT_EQ(tl.FindById(1), nullptr);
+        EXPECT_EQ(tl.FindById(4)->GetDescription(), "Fourth");
+        EXPECT_EQ(tl.FindById(4)->GetUpdatedAt(), expected[3].GetUpdatedAt());
+        EXPECT_EQ(tl.FindById(2)->GetDescription(), expected[1].GetDescription());
+        EXPECT_EQ(tl.FindById(2)->GetCreatedAt(), expected[1].GetCreatedAt());
+        EXPECT_EQ(tl.FindById(3)->GetDescription(), "Third");
+        EXPECT_EQ(tl.FindById(3)->GetCreatedAt(), expected[2].GetCreatedAt());
+        EXPECT_EQ(tl.FindById(3)->GetStatus(), Task::Status::DONE);
+    }
+    
+    // Queries over all tasks see every field
+    CreateTestJsonFile(store);
+    TaskList tl(testJsonPath, lazy);
+    TaskFilter created;
+    created.createdFrom = expected[1].GetCreatedAt();
+    auto view = tl.Select(created);
+    ASSERT_EQ(view.size(), 3);
+    EXPECT_EQ(view[0].GetDescription(), expected[1].GetDescription());
+    EXPECT_EQ(tl.FindByKeyWord("third").size(), 1);
+}
+
+TEST_F(TaskListTest, CountByStatus) {
+    TaskList tl(testJsonPath);
+    tl.AddTask("Task 1");
+    tl.AddTask("Task 2");
+    tl.AddTask("Task 3");
+    EXPECT_EQ(tl.CountByStatus(Task::Status::TODO), 3);
+    
+    tl.MarkTask(1, Task::Status::DONE);
+    tl.MarkTask(3, Task::Status::IN_PROGRESS);
+    tl.MarkTask(3, Task::Status::IN_PROGRESS);
+    EXPECT_EQ(tl.CountByStatus(Task::Status::TODO), 1);
+    EXPECT_EQ(tl.CountByStatus(Task::Status::IN_PROGRESS), 1);
+    EXPECT_EQ(tl.CountByStatus(Task::Status::DONE), 1);
+    
+    // Ids of the other tasks stay valid after a removal
+    tl.RemoveTask(1);
+    EXPECT_EQ(tl.CountByStatus(Task::Status::DONE), 0);
+    auto inProgress = tl.GetByStatus(Task::Status::IN_PROGRESS);
+    ASSERT_EQ(inProgress.size(), 1);
+    EXPECT_EQ(inProgress[0].GetDescription(), "Task 3");
+}
+
 TEST_F(TaskListTest, GetByStatusEmptyResult) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
-    tl.MarkTask(0, Task::Status::TODO);
+    tl.MarkTask(1, Task::Status::TODO);
     
     auto doneTasks = tl.GetByStatus(Task::Status::DONE);
     EXPECT_EQ(doneTasks.size(), 0);
@@ -223,16 +529,16 @@ TEST_F(TaskListTest, GetByStatusEmptyResult) {
 
 // ListTasks Tests
 TEST_F(TaskListTest, ListTasksWithValidStatus) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
-    tl.MarkTask(0, Task::Status::TODO);
+    tl.MarkTask(1, Task::Status::TODO);
     
     bool result = tl.ListTasks("todo");
     EXPECT_TRUE(result);
 }
 
 TEST_F(TaskListTest, ListTasksWithInvalidStatus) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
     bool result = tl.ListTasks("invalid-status");
@@ -240,25 +546,75 @@ TEST_F(TaskListTest, ListTasksWithInvalidStatus) {
 }
 
 TEST_F(TaskListTest, ListTasksWithEmptyStatus) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
     bool result = tl.ListTasks("");
     EXPECT_TRUE(result); // Should list all tasks
 }
 
-// FindByKeyWord Tests (currently unimplemented)
+// FindByKeyWord Tests
 TEST_F(TaskListTest, FindByKeyWord) {
-    TaskList tl;
-    tl.AddTask("Test Task");
-    
-    auto results = tl.FindByKeyWord("Test");
-    EXPECT_EQ(results.size(), 0); // Currently returns empty vector
+    TaskList tl(testJsonPath);
+    tl.AddTask("Fix parser crash");
+    tl.AddTask("Deploy parser service");
+    tl.AddTask("Write docs");
+    
+    auto found = tl.FindByKeyWord("parser");
+    ASSERT_EQ(found.size(), 2);
+    EXPECT_EQ(found[0].GetDescription(), "Fix parser crash");
+    EXPECT_EQ(found[1].GetDescription(), "Deploy parser service");
+    
+    EXPECT_EQ(tl.FindByKeyWord("deploy* OR docs").size(), 2);
+    EXPECT_TRUE(tl.FindByKeyWord("missing").empty());
+}
+
+TEST_F(TaskListTest, FindByKeyWordFollowsMutations) {
+    TaskList tl(testJsonPath);
+    tl.AddTask("Fix parser crash");
+    tl.AddTask("Write docs");
+    // The first search scans, the second builds the index
+    EXPECT_EQ(tl.FindByKeyWord("parser").size(), 1);
+    EXPECT_EQ(tl.FindByKeyWord("docs").size(), 1);
+    
+    // The index has to be kept current
+    tl.AddTask("Parser docs");
+    EXPECT_EQ(tl.FindByKeyWord("parser").size(), 2);
+    
+    tl.UpdateTask(1, "Fix lexer crash");
+    auto found = tl.FindByKeyWord("parser");
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found[0].GetDescription(), "Parser docs");
+    EXPECT_EQ(tl.FindByKeyWord("lexer").size(), 1);
+    
+    tl.RemoveTask(3);
+    EXPECT_TRUE(tl.FindByKeyWord("parser").empty());
+    EXPECT_EQ(tl.FindByKeyWord("docs").size(), 1);
+}
+
+TEST_F(TaskListTest, FindByKeyWordSubstring) {
+    TaskList tl(testJsonPath);
+    tl.AddTask("Fix PARSER crash");
+    tl.AddTask("Write docs");
+    tl.AddTask("Sparse matrix");
+    
+    // Infix fragments fall back to a case-insensitive scan
+    auto found = tl.FindByKeyWord("*ARSE*");
+    ASSERT_EQ(found.size(), 2);
+    EXPECT_EQ(found[0].GetDescription(), "Fix PARSER crash");
+    EXPECT_EQ(found[1].GetDescription(), "Sparse matrix");
+    
+    // Mixed with index terms, and current after mutations
+    EXPECT_EQ(tl.FindByKeyWord("*arse* crash").size(), 1);
+    tl.UpdateTask(2, "Parse docs");
+    EXPECT_EQ(tl.FindByKeyWord("*arse*").size(), 3);
+    tl.RemoveTask(1);
+    EXPECT_EQ(tl.FindByKeyWord("*arse*").size(), 2);
 }
 
 // Edge Cases
 TEST_F(TaskListTest, TaskWithSpecialCharacters) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     std::string specialDesc = "Task with \"quotes\", \n newlines, \t tabs, and unicode: 🚀";
     
     bool result = tl.AddTask(specialDesc);
@@ -266,7 +622,7 @@ TEST_F(TaskListTest, TaskWithSpecialCharacters) {
 }
 
 TEST_F(TaskListTest, MaximumLengthDescription) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     std::string maxDesc(1000, 'a');
     
     bool result = tl.AddTask(maxDesc);
@@ -274,7 +630,7 @@ TEST_F(TaskListTest, MaximumLengthDescription) {
 }
 
 TEST_F(TaskListTest, BoundaryLengthDescription) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     std::string boundaryDesc(1001, 'a');
     
     bool result = tl.AddTask(boundaryDesc);
@@ -283,7 +639,7 @@ TEST_F(TaskListTest, BoundaryLengthDescription) {
 
 // Stress Tests
 TEST_F(TaskListTest, AddManyTasks) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     size_t old_size = tl.Size();
     for (int i = 0; i < 100; ++i) {
         std::string desc = "Task " + std::to_string(i);
@@ -294,7 +650,7 @@ TEST_F(TaskListTest, AddManyTasks) {
 }
 
 TEST_F(TaskListTest, RemoveAllTasks) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     
     // Add some tasks
     for (int i = 0; i < 5; ++i) {
@@ -305,7 +661,7 @@ TEST_F(TaskListTest, RemoveAllTasks) {
     
     // Remove all tasks
     for (size_t i = 0; i < initialSize; ++i) {
-        EXPECT_TRUE(tl.RemoveTask(0)); // Always remove first task
+        EXPECT_TRUE(tl.RemoveTask(static_cast<int>(i) + 1));
     }
     
     EXPECT_EQ(tl.Size(), 0);
@@ -313,20 +669,20 @@ TEST_F(TaskListTest, RemoveAllTasks) {
 
 // Integration Tests
 TEST_F(TaskListTest, FullTaskLifecycle) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     
     // Add task
     EXPECT_TRUE(tl.AddTask("Lifecycle Task"));
     EXPECT_EQ(tl.Size(), 1);
     
     // Update task
-    EXPECT_TRUE(tl.UpdateTask(0, "Updated Lifecycle Task"));
+    EXPECT_TRUE(tl.UpdateTask(1, "Updated Lifecycle Task"));
     
     // Mark task as in progress
-    EXPECT_TRUE(tl.MarkTask(0, Task::Status::IN_PROGRESS));
+    EXPECT_TRUE(tl.MarkTask(1, Task::Status::IN_PROGRESS));
     
     // Mark task as done
-    EXPECT_TRUE(tl.MarkTask(0, Task::Status::DONE));
+    EXPECT_TRUE(tl.MarkTask(1, Task::Status::DONE));
     
     // Verify status
     auto doneTasks = tl.GetByStatus(Task::Status::DONE);
@@ -334,13 +690,13 @@ TEST_F(TaskListTest, FullTaskLifecycle) {
     EXPECT_EQ(doneTasks[0].GetDescription(), "Updated Lifecycle Task");
     
     // Remove task
-    EXPECT_TRUE(tl.RemoveTask(0));
+    EXPECT_TRUE(tl.RemoveTask(1));
     EXPECT_EQ(tl.Size(), 0);
 }
 
 // Error Handling Tests
 TEST_F(TaskListTest, OperationsOnEmptyList) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     
     EXPECT_FALSE(tl.UpdateTask(0, "Updated"));
     EXPECT_FALSE(tl.RemoveTask(0));
@@ -351,10 +707,10 @@ TEST_F(TaskListTest, OperationsOnEmptyList) {
 }
 
 TEST_F(TaskListTest, InvalidOperations) {
-    TaskList tl;
+    TaskList tl(testJsonPath);
     tl.AddTask("Test Task");
     
-    // Test with invalid indices
+    // Test with unknown ids
     EXPECT_FALSE(tl.UpdateTask(-1, "Updated"));
     EXPECT_FALSE(tl.RemoveTask(-1));
     EXPECT_FALSE(tl.MarkTask(-1, Task::Status::DONE));
@@ -363,3 +719,122 @@ TEST_F(TaskListTest, InvalidOperations) {
     EXPECT_FALSE(tl.RemoveTask(999));
     EXPECT_FALSE(tl.MarkTask(999, Task::Status::DONE));
 }
+
+// Several processes sharing one store
+TEST_F(TaskListTest, JournaledListsSeeEachOthersChanges) {
+    TaskListOptions options;
+    options.persistence = TaskListOptions::Persistence::JOURNAL;
+    TaskList a(testJsonPath, options);
+    TaskList b(testJsonPath, options);
+    
+    ASSERT_TRUE(a.AddTask("from a"));
+    ASSERT_TRUE(b.AddTask("from b"));
+    EXPECT_TRUE(b.MarkTask(1, Task::Status::DONE));
+    EXPECT_TRUE(a.UpdateTask(2, "from b, updated by a"));
+    ASSERT_TRUE(b.Flush());
+    EXPECT_TRUE(a.RemoveTask(1));
+    
+    TaskList c(testJsonPath, options);
+    ASSERT_EQ(c.Size(), 1);
+    EXPECT_EQ(c.FindById(2)->GetDescription(), "from b, updated by a");
+}
+
+TEST_F(TaskListTest, RewritingListsMergeTheirChanges) {
+    CreateTestJsonFile(R"([{"id": 1, "description": "shared", "status": "TODO", )"
+        R"("createdAt": "2025-08-02 23:08:45", "updatedAt": "null"}])");
+    {
+        TaskList a(testJsonPath);
+        TaskList b(testJsonPath);
+        ASSERT_TRUE(a.AddTask("from a"));
+        ASSERT_TRUE(a.MarkTask(1, Task::Status::DONE));
+        ASSERT_TRUE(b.AddTask("from b"));
+        ASSERT_TRUE(b.UpdateTask(1, "renamed by b"));
+        // b saves first, a finds the store replaced and merges into it
+    }
+    
+    TaskList tl(testJsonPath);
+    ASSERT_EQ(tl.Size(), 3);
+    EXPECT_EQ(tl.FindById(1)->GetDescription(), "renamed by b");
+    EXPECT_EQ(tl.FindById(1)->GetStatus(), Task::Status::DONE);
+    EXPECT_EQ(tl.FindById(2)->GetDescription(), "from b");
+    EXPECT_EQ(tl.FindById(3)->GetDescription(), "from a");
+}
+
+TEST_F(TaskListTest, RemovedIdsAreNotReused) {
+    struct Setup {
+        TaskListOptions::Persistence persistence;
+        TaskListOptions::Format format;
+    };
+    for (auto setup : {Setup{TaskListOptions::Persistence::REWRITE, TaskListOptions::Format::JSON},
+        Setup{TaskListOptions::Persistence::JOURNAL, TaskListOptions::Format::JSON},
+        Setup{TaskListOptions::Persistence::JOURNAL, TaskListOptions::Format::BINARY}}) {
+        TearDown();
+        TaskListOptions options;
+        options.persistence = setup.persistence;
+        options.format = setup.format;
+        {
+            TaskList tl(testJsonPath, options);
+            for (auto desc : {"First", "Second", "Third"})
+                ASSERT_TRUE(tl.AddTask(desc));
+            ASSERT_TRUE(tl.RemoveTask(3));
+            ASSERT_TRUE(tl.RemoveTask(2));
+            // Compacts the journal, only the store knows about ids 2 and 3
+            ASSERT_TRUE(tl.Flush());
+        }
+        
+        TaskList tl(testJsonPath, options);
+        ASSERT_EQ(tl.Size(), 1);
+        EXPECT_EQ(tl.NextId(), 4);
+        ASSERT_TRUE(tl.AddTask("Fourth"));
+        ASSERT_NE(tl.FindById(4), nullptr);
+        EXPECT_EQ(tl.FindById(4)->GetDescription(), "Fourth");
+    }
+}
+
+TEST_F(TaskListTest, ConcurrentProcessesLoseNoUpdates) {
+#ifdef _WIN32
+    GTEST_SKIP() << "fork only";
+#else
+    constexpr int PROCESSES = 4;
+    constexpr int SESSIONS = 50;
+    for (auto persistence : {TaskListOptions::Persistence::JOURNAL, TaskListOptions::Persistence::REWRITE}) {
+        TearDown();
+        TaskListOptions options;
+        options.persistence = persistence;
+        // Small enough that the processes compact while others append
+        options.journalCompactBytes = 2048;
+        
+        // Each session is one short task-cli run: load, add, save
+        std::vector<pid_t> children;
+        for (int p = 0; p < PROCESSES; ++p) {
+            pid_t pid = fork();
+            ASSERT_GE(pid, 0);
+            if (pid == 0) {
+                bool ok = true;
+                for (int i = 0; i < SESSIONS; ++i) {
+                    TaskList tl(testJsonPath, options);
+                    ok = tl.AddTask("process " + std::to_string(p) + " session " + std::to_string(i)) && ok;
+                }
+                _exit(ok ? 0 : 1);
+            }
+            children.push_back(pid);
+        }
+        for (pid_t pid : children) {
+            int status = 0;
+            ASSERT_EQ(waitpid(pid, &status, 0), pid);
+            EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        }
+        
+        TaskList tl(testJsonPath, options);
+        ASSERT_EQ(tl.Size(), PROCESSES * SESSIONS);
+        std::set<std::string> descriptions;
+        std::set<int> ids;
+        for (const Task& task : tl.Select({})) {
+            descriptions.emplace(task.GetDescription());
+            ids.insert(task.GetId());
+        }
+        EXPECT_EQ(descriptions.size(), PROCESSES * SESSIONS);
+        EXPECT_EQ(ids.size(), PROCESSES * SESSIONS);
+    }
+#endif
+}
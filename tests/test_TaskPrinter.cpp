@@ -0,0 +1,87 @@
+#include "../src/TaskPrinter.h"
+#include "../src/TimeCodec.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+namespace {
+    std::chrono::system_clock::time_point At(const char* text) {
+        return *TimeCodec::Parse(text);
+    }
+}
+
+TEST(TaskPrinterTest, TextMatchesPrintTask) {
+    Task never(1, "first", Task::Status::TODO, At("2025-08-02 23:08:45"), std::nullopt);
+    Task updated(2, "second", Task::Status::DONE, At("2025-08-02 23:08:45"), At("2025-08-03 09:48:07"));
+    
+    std::ostringstream expected;
+    never.PrintTask(expected);
+    updated.PrintTask(expected);
+    
+    std::ostringstream out;
+    {
+        TaskPrinter printer(out);
+        printer.Print(never);
+        printer.Print(updated);
+    }
+    EXPECT_EQ(out.str(), expected.str());
+}
+
+TEST(TaskPrinterTest, FormatsOneLinePerTask) {
+    Task task(7, "tab\there \"quoted\"\n", Task::Status::IN_PROGRESS, 
+        At("2025-08-02 23:08:45"), std::nullopt);
+    auto print = [&](TaskPrinter::Format format) {
+        std::ostringstream out;
+        TaskPrinter printer(out, format);
+        printer.Print(task);
+        printer.Flush();
+        return out.str();
+    };
+    
+    EXPECT_EQ(print(TaskPrinter::Format::JSONL),
+        "{\"id\":7,\"description\":\"tab\\there \\\"quoted\\\"\\n\",\"status\":\"IN_PROGRESS\","
+        "\"createdAt\":\"2025-08-02 23:08:45\",\"updatedAt\":null}\n");
+    EXPECT_EQ(print(TaskPrinter::Format::TSV),
+        "7\tIN_PROGRESS\t2025-08-02 23:08:45\tnull\ttab\\there \"quoted\"\\n\n");
+    
+    std::string table = print(TaskPrinter::Format::TABLE);
+    auto header = table.substr(0, table.find('\n') + 1);
+    auto row = table.substr(header.size());
+    EXPECT_EQ(header.find("id"), 4);
+    EXPECT_EQ(row.substr(0, 6), "     7");
+    EXPECT_EQ(row.find("IN_PROGRESS"), header.find("status"));
+    EXPECT_EQ(row.find("2025-08-02"), header.find("createdAt"));
+    EXPECT_EQ(row.find("null"), header.find("updatedAt"));
+    EXPECT_EQ(row.find("tab"), header.find("description"));
+    // Control characters cannot break the row
+    EXPECT_EQ(row.substr(row.find("tab")), "tab\\there \"quoted\"\\n\n");
+    
+    Task control(8, "bell\a\x1b[31m C:\\temp", Task::Status::TODO, At("2025-08-02 23:08:45"), std::nullopt);
+    std::ostringstream text;
+    {
+        TaskPrinter printer(text);
+        printer.Print(task);
+        printer.Print(control);
+    }
+    EXPECT_NE(text.str().find("description: tab\\there \"quoted\"\\n\nstatus:"), std::string::npos);
+    EXPECT_NE(text.str().find("description: bell\\x07\\x1b[31m C:\\temp\n"), std::string::npos);
+    
+    EXPECT_EQ(TaskPrinter::ParseFormat("tsv"), TaskPrinter::Format::TSV);
+    EXPECT_FALSE(TaskPrinter::ParseFormat("csv").has_value());
+}
+
+TEST(TaskPrinterTest, LargeOutputArrivesComplete) {
+    std::ostringstream expected;
+    std::ostringstream out;
+    {
+        TaskPrinter printer(out);
+        for (int id = 1; id <= 5000; ++id) {
+            // Every task a second later, so the timestamp cache misses too
+            Task task(id, "task number " + std::to_string(id), Task::Status::TODO,
+                At("2025-08-02 23:08:45") + std::chrono::seconds(id / 2), std::nullopt);
+            task.PrintTask(expected);
+            printer.Print(task);
+        }
+    }
+    EXPECT_EQ(out.str(), expected.str());
+}
@@ -0,0 +1,88 @@
+#include "../src/TimeCodec.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+
+// Compare against the C library in a zone with DST transitions
+class TimeCodecTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        #ifndef _WIN32
+            setenv("TZ", "Europe/Berlin", 1);
+            tzset();
+        #endif
+    }
+
+    static std::string PutTime(std::time_t t) {
+        std::tm tm{};
+        #ifdef _WIN32
+            localtime_s(&tm, &t);
+        #else
+            localtime_r(&t, &tm);
+        #endif
+        std::ostringstream oss;
+        oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+        return oss.str();
+    }
+
+    static std::string Format(std::chrono::system_clock::time_point tp) {
+        char buf[TimeCodec::TIMESTAMP_SIZE];
+        TimeCodec::Format(tp, buf);
+        return std::string(buf, sizeof(buf));
+    }
+};
+
+TEST_F(TimeCodecTest, FormatMatchesPutTime) {
+    std::mt19937_64 rng{7};
+    for (int i = 0; i < 20000; ++i) {
+        // 1990 .. 2040
+        std::time_t t = static_cast<std::time_t>(631152000 + rng() % 1577836800);
+        EXPECT_EQ(Format(std::chrono::system_clock::from_time_t(t)), PutTime(t)) << t;
+    }
+}
+
+TEST_F(TimeCodecTest, FormatTruncatesSubSeconds) {
+    auto tp = std::chrono::system_clock::from_time_t(1754171304) + std::chrono::milliseconds(999);
+    EXPECT_EQ(Format(tp), PutTime(1754171304));
+}
+
+TEST_F(TimeCodecTest, ParseRoundTrip) {
+    std::mt19937_64 rng{11};
+    for (int i = 0; i < 20000; ++i) {
+        std::time_t t = static_cast<std::time_t>(631152000 + rng() % 1577836800);
+        std::string text = PutTime(t);
+        auto parsed = TimeCodec::Parse(text);
+        ASSERT_TRUE(parsed.has_value()) << text;
+        // Inside the autumn overlap both offsets are valid readings
+        EXPECT_EQ(Format(*parsed), text);
+    }
+}
+
+TEST_F(TimeCodecTest, ParseMatchesMktime) {
+    for (const char* text : {"2025-08-02 23:56:24", "2025-01-15 08:00:00",
+                             "2000-02-29 12:30:45", "2025-03-30 03:00:00"}) {
+        std::tm tm{};
+        std::istringstream ss{text};
+        ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+        tm.tm_isdst = -1;
+        auto expected = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+        EXPECT_EQ(TimeCodec::Parse(text), expected) << text;
+    }
+}
+
+TEST_F(TimeCodecTest, ParseRejectsInvalidInput) {
+    EXPECT_FALSE(TimeCodec::Parse(""));
+    EXPECT_FALSE(TimeCodec::Parse("null"));
+    EXPECT_FALSE(TimeCodec::Parse("invalid-date-format"));
+    EXPECT_FALSE(TimeCodec::Parse("2025-8-2 23:56:24"));
+    EXPECT_FALSE(TimeCodec::Parse("2025-08-02T23:56:24"));
+    EXPECT_FALSE(TimeCodec::Parse("2025-13-02 23:56:24"));
+    EXPECT_FALSE(TimeCodec::Parse("2025-02-29 23:56:24"));
+    EXPECT_FALSE(TimeCodec::Parse("2025-08-02 24:00:00"));
+    EXPECT_FALSE(TimeCodec::Parse("2025-08-02 23:56:24 "));
+}